@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom2_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom1_usart.c ../src/config/default/peripheral/tc/plib_tc1.c ../src/config/default/peripheral/tc/plib_tc0.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/main.c ../src/flugprotokoll.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom2_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom1_usart.c ../src/config/default/peripheral/tc/plib_tc1.c ../src/config/default/peripheral/tc/plib_tc0.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/main.c ../src/flugprotokoll.c ../src/gps.c ../src/nmea.c ../src/systime.c ../src/uart_line.c ../src/hotstart.c ../src/geo.c ../src/divas_math.c ../src/compass.c ../src/trig.c ../src/pid.c ../src/predictor.c ../src/heading.c ../src/timer.c ../src/scheduler.c ../src/control_tick.c ../src/power.c ../src/geo_benchmark.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o ${OBJECTDIR}/_ext/829342655/plib_tc1.o ${OBJECTDIR}/_ext/829342655/plib_tc0.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o.d ${OBJECTDIR}/_ext/1986646378/plib_evsys.o.d ${OBJECTDIR}/_ext/1865468468/plib_nvic.o.d ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/1865521619/plib_port.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o.d ${OBJECTDIR}/_ext/829342655/plib_tc1.o.d ${OBJECTDIR}/_ext/829342655/plib_tc0.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1171490990/startup_xc32.o.d ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o ${OBJECTDIR}/_ext/829342655/plib_tc1.o ${OBJECTDIR}/_ext/829342655/plib_tc0.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o ${OBJECTDIR}/_ext/1360937237/gps.o ${OBJECTDIR}/_ext/1360937237/nmea.o ${OBJECTDIR}/_ext/1360937237/systime.o ${OBJECTDIR}/_ext/1360937237/uart_line.o ${OBJECTDIR}/_ext/1360937237/hotstart.o ${OBJECTDIR}/_ext/1360937237/geo.o ${OBJECTDIR}/_ext/1360937237/divas_math.o ${OBJECTDIR}/_ext/1360937237/compass.o ${OBJECTDIR}/_ext/1360937237/trig.o ${OBJECTDIR}/_ext/1360937237/pid.o ${OBJECTDIR}/_ext/1360937237/predictor.o ${OBJECTDIR}/_ext/1360937237/heading.o ${OBJECTDIR}/_ext/1360937237/timer.o ${OBJECTDIR}/_ext/1360937237/scheduler.o ${OBJECTDIR}/_ext/1360937237/control_tick.o ${OBJECTDIR}/_ext/1360937237/power.o ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o.d ${OBJECTDIR}/_ext/1986646378/plib_evsys.o.d ${OBJECTDIR}/_ext/1865468468/plib_nvic.o.d ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/1865521619/plib_port.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o.d ${OBJECTDIR}/_ext/829342655/plib_tc1.o.d ${OBJECTDIR}/_ext/829342655/plib_tc0.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1171490990/startup_xc32.o.d ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o.d ${OBJECTDIR}/_ext/1360937237/gps.o.d ${OBJECTDIR}/_ext/1360937237/nmea.o.d ${OBJECTDIR}/_ext/1360937237/systime.o.d ${OBJECTDIR}/_ext/1360937237/uart_line.o.d ${OBJECTDIR}/_ext/1360937237/hotstart.o.d ${OBJECTDIR}/_ext/1360937237/geo.o.d ${OBJECTDIR}/_ext/1360937237/divas_math.o.d ${OBJECTDIR}/_ext/1360937237/compass.o.d ${OBJECTDIR}/_ext/1360937237/trig.o.d ${OBJECTDIR}/_ext/1360937237/pid.o.d ${OBJECTDIR}/_ext/1360937237/predictor.o.d ${OBJECTDIR}/_ext/1360937237/heading.o.d ${OBJECTDIR}/_ext/1360937237/timer.o.d ${OBJECTDIR}/_ext/1360937237/scheduler.o.d ${OBJECTDIR}/_ext/1360937237/control_tick.o.d ${OBJECTDIR}/_ext/1360937237/power.o.d ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o ${OBJECTDIR}/_ext/829342655/plib_tc1.o ${OBJECTDIR}/_ext/829342655/plib_tc0.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o
+OBJECTFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom2_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom1_usart.o ${OBJECTDIR}/_ext/829342655/plib_tc1.o ${OBJECTDIR}/_ext/829342655/plib_tc0.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o ${OBJECTDIR}/_ext/1360937237/gps.o ${OBJECTDIR}/_ext/1360937237/nmea.o ${OBJECTDIR}/_ext/1360937237/systime.o ${OBJECTDIR}/_ext/1360937237/uart_line.o ${OBJECTDIR}/_ext/1360937237/hotstart.o ${OBJECTDIR}/_ext/1360937237/geo.o ${OBJECTDIR}/_ext/1360937237/divas_math.o ${OBJECTDIR}/_ext/1360937237/compass.o ${OBJECTDIR}/_ext/1360937237/trig.o ${OBJECTDIR}/_ext/1360937237/pid.o ${OBJECTDIR}/_ext/1360937237/predictor.o ${OBJECTDIR}/_ext/1360937237/heading.o ${OBJECTDIR}/_ext/1360937237/timer.o ${OBJECTDIR}/_ext/1360937237/scheduler.o ${OBJECTDIR}/_ext/1360937237/control_tick.o ${OBJECTDIR}/_ext/1360937237/power.o ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o
 
 # Source Files
-SOURCEFILES=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom2_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom1_usart.c ../src/config/default/peripheral/tc/plib_tc1.c ../src/config/default/peripheral/tc/plib_tc0.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/main.c ../src/flugprotokoll.c
+SOURCEFILES=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom2_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom1_usart.c ../src/config/default/peripheral/tc/plib_tc1.c ../src/config/default/peripheral/tc/plib_tc0.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/main.c ../src/flugprotokoll.c ../src/gps.c ../src/nmea.c ../src/systime.c ../src/uart_line.c ../src/hotstart.c ../src/geo.c ../src/divas_math.c ../src/compass.c ../src/trig.c ../src/pid.c ../src/predictor.c ../src/heading.c ../src/timer.c ../src/scheduler.c ../src/control_tick.c ../src/power.c ../src/geo_benchmark.c
 
 # Pack Options 
 PACK_COMMON_OPTIONS=-I "${CMSIS_DIR}/CMSIS/Core/Include"
@@ -224,6 +224,108 @@ ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o: ../src/flugprotokoll.c  .generated
 	@${RM} ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/flugprotokoll.o.d" -o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o ../src/flugprotokoll.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/gps.o: ../src/gps.c  .generated_files/flags/default/f0573ebcc617212a5bd9cd737c8711c67e975080 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gps.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gps.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/gps.o.d" -o ${OBJECTDIR}/_ext/1360937237/gps.o ../src/gps.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/nmea.o: ../src/nmea.c  .generated_files/flags/default/9495cd4b6e049c89c920082296a066b5793f1bff .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nmea.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nmea.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nmea.o.d" -o ${OBJECTDIR}/_ext/1360937237/nmea.o ../src/nmea.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/systime.o: ../src/systime.c  .generated_files/flags/default/75439ca9b1ac2d4772d3785a9f699f239108db53 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/systime.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/systime.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/systime.o.d" -o ${OBJECTDIR}/_ext/1360937237/systime.o ../src/systime.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/uart_line.o: ../src/uart_line.c  .generated_files/flags/default/a67965bf50bbd839714c2ff75bd7f98a442cb921 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_line.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_line.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/uart_line.o.d" -o ${OBJECTDIR}/_ext/1360937237/uart_line.o ../src/uart_line.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/hotstart.o: ../src/hotstart.c  .generated_files/flags/default/4bce3f36cbeb606bddd5f519961bb08142a822dc .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hotstart.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hotstart.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/hotstart.o.d" -o ${OBJECTDIR}/_ext/1360937237/hotstart.o ../src/hotstart.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/geo.o: ../src/geo.c  .generated_files/flags/default/98be1bf21bc3654c57d50fc97823a230a061b6e6 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/geo.o.d" -o ${OBJECTDIR}/_ext/1360937237/geo.o ../src/geo.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/divas_math.o: ../src/divas_math.c  .generated_files/flags/default/4a8b37738e4bca0083734394b587af68013d46f1 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/divas_math.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/divas_math.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/divas_math.o.d" -o ${OBJECTDIR}/_ext/1360937237/divas_math.o ../src/divas_math.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/compass.o: ../src/compass.c  .generated_files/flags/default/e39e3a5bc6ba9c869b86f22d89a834a8597dd566 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/compass.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/compass.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/compass.o.d" -o ${OBJECTDIR}/_ext/1360937237/compass.o ../src/compass.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/trig.o: ../src/trig.c  .generated_files/flags/default/302705d5108aea23f71a71a72f882c06d2e110d8 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trig.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trig.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/trig.o.d" -o ${OBJECTDIR}/_ext/1360937237/trig.o ../src/trig.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/pid.o: ../src/pid.c  .generated_files/flags/default/ccc6ae1c074a2f9ec08d533fb0c7dd680ec427e2 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pid.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pid.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/pid.o.d" -o ${OBJECTDIR}/_ext/1360937237/pid.o ../src/pid.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/predictor.o: ../src/predictor.c  .generated_files/flags/default/eb9303ebad68e2dbae3c8877640697f82df3f51a .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/predictor.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/predictor.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/predictor.o.d" -o ${OBJECTDIR}/_ext/1360937237/predictor.o ../src/predictor.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/heading.o: ../src/heading.c  .generated_files/flags/default/223e58d7397738a024bd32a73728d80f04901fe8 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/heading.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/heading.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/heading.o.d" -o ${OBJECTDIR}/_ext/1360937237/heading.o ../src/heading.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/timer.o: ../src/timer.c  .generated_files/flags/default/5fdc31c5a6c5d978ed53ce3ac77e9d19642ad650 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/timer.o.d" -o ${OBJECTDIR}/_ext/1360937237/timer.o ../src/timer.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/scheduler.o: ../src/scheduler.c  .generated_files/flags/default/274e1318b6b3ee0226e292692e942eadbdb64765 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/scheduler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/scheduler.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/scheduler.o.d" -o ${OBJECTDIR}/_ext/1360937237/scheduler.o ../src/scheduler.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/control_tick.o: ../src/control_tick.c  .generated_files/flags/default/dfe3a5f224288c192ef829e0142204d13362725e .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/control_tick.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/control_tick.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/control_tick.o.d" -o ${OBJECTDIR}/_ext/1360937237/control_tick.o ../src/control_tick.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/power.o: ../src/power.c  .generated_files/flags/default/08a43e9e35c2cabbd53137b500a0e2d9066d5042 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/power.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/power.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/power.o.d" -o ${OBJECTDIR}/_ext/1360937237/power.o ../src/power.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/geo_benchmark.o: ../src/geo_benchmark.c  .generated_files/flags/default/c76dfa729a6a27673ac03b59f27b08248246404f .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/geo_benchmark.o.d" -o ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o ../src/geo_benchmark.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
 else
 ${OBJECTDIR}/_ext/1984496892/plib_clock.o: ../src/config/default/peripheral/clock/plib_clock.c  .generated_files/flags/default/e78a273771d35db4ec0c85b496f8538826a91f15 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
 	@${MKDIR} "${OBJECTDIR}/_ext/1984496892" 
@@ -339,6 +441,108 @@ ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o: ../src/flugprotokoll.c  .generated
 	@${RM} ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o 
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/flugprotokoll.o.d" -o ${OBJECTDIR}/_ext/1360937237/flugprotokoll.o ../src/flugprotokoll.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/gps.o: ../src/gps.c  .generated_files/flags/default/53e0ea2144acdbd46cab1fdbdc2111ad26395ade .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gps.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gps.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/gps.o.d" -o ${OBJECTDIR}/_ext/1360937237/gps.o ../src/gps.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/nmea.o: ../src/nmea.c  .generated_files/flags/default/612076ad53138f4924ed935b0b06ada06a7c87c1 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nmea.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nmea.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nmea.o.d" -o ${OBJECTDIR}/_ext/1360937237/nmea.o ../src/nmea.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/systime.o: ../src/systime.c  .generated_files/flags/default/c9a1172a9913464c5677c1943ba0f0430dd80ebc .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/systime.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/systime.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/systime.o.d" -o ${OBJECTDIR}/_ext/1360937237/systime.o ../src/systime.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/uart_line.o: ../src/uart_line.c  .generated_files/flags/default/a852b7774bbd5db48a37275110ea21246d3e1968 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_line.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_line.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/uart_line.o.d" -o ${OBJECTDIR}/_ext/1360937237/uart_line.o ../src/uart_line.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/hotstart.o: ../src/hotstart.c  .generated_files/flags/default/631a65b178ec373af250498c54f20b9547ff65ba .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hotstart.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/hotstart.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/hotstart.o.d" -o ${OBJECTDIR}/_ext/1360937237/hotstart.o ../src/hotstart.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/geo.o: ../src/geo.c  .generated_files/flags/default/5877600e839829042a4e21ee48ca0d260e41ad20 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/geo.o.d" -o ${OBJECTDIR}/_ext/1360937237/geo.o ../src/geo.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/divas_math.o: ../src/divas_math.c  .generated_files/flags/default/0420b58f6c38b4f5f1e50c723a650988f35c5726 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/divas_math.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/divas_math.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/divas_math.o.d" -o ${OBJECTDIR}/_ext/1360937237/divas_math.o ../src/divas_math.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/compass.o: ../src/compass.c  .generated_files/flags/default/42afbcba9a5c62213f0436c83ad9f0055a82520c .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/compass.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/compass.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/compass.o.d" -o ${OBJECTDIR}/_ext/1360937237/compass.o ../src/compass.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/trig.o: ../src/trig.c  .generated_files/flags/default/fc08c62dc2637c1726f5f2366a19b808eddd5495 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trig.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trig.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/trig.o.d" -o ${OBJECTDIR}/_ext/1360937237/trig.o ../src/trig.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/pid.o: ../src/pid.c  .generated_files/flags/default/2cfe98f3c4b0ec39e0998f64bd7d748318a4e115 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pid.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/pid.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/pid.o.d" -o ${OBJECTDIR}/_ext/1360937237/pid.o ../src/pid.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/predictor.o: ../src/predictor.c  .generated_files/flags/default/9335c2c42a3912086150087744efb6dc6b17b33a .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/predictor.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/predictor.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/predictor.o.d" -o ${OBJECTDIR}/_ext/1360937237/predictor.o ../src/predictor.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/heading.o: ../src/heading.c  .generated_files/flags/default/01de402f0c309b32e716d8748bfb349e4c31e47c .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/heading.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/heading.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/heading.o.d" -o ${OBJECTDIR}/_ext/1360937237/heading.o ../src/heading.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/timer.o: ../src/timer.c  .generated_files/flags/default/fc2d6c56b702020081c6073287b2c961dd32b819 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/timer.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/timer.o.d" -o ${OBJECTDIR}/_ext/1360937237/timer.o ../src/timer.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/scheduler.o: ../src/scheduler.c  .generated_files/flags/default/ecf63698a123afff2a7cd388f9af782595342484 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/scheduler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/scheduler.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/scheduler.o.d" -o ${OBJECTDIR}/_ext/1360937237/scheduler.o ../src/scheduler.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/control_tick.o: ../src/control_tick.c  .generated_files/flags/default/7d8d11acfb74c1a6f6b8f4f066539b22bc65c47b .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/control_tick.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/control_tick.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/control_tick.o.d" -o ${OBJECTDIR}/_ext/1360937237/control_tick.o ../src/control_tick.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/power.o: ../src/power.c  .generated_files/flags/default/8ff924c35bee269d0d4169358b3d5fe37fbb6c67 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/power.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/power.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/power.o.d" -o ${OBJECTDIR}/_ext/1360937237/power.o ../src/power.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/geo_benchmark.o: ../src/geo_benchmark.c  .generated_files/flags/default/86c2c36d6ba65ecd803c237ea867ec95a479d5f1 .generated_files/flags/default/dfb6e4af1f06d3a3780023d2ba77b9a428a79132
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -I"../src/packs/PIC32CM1216MC00032_DFP" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/geo_benchmark.o.d" -o ${OBJECTDIR}/_ext/1360937237/geo_benchmark.o ../src/geo_benchmark.c    -DXPRJ_default=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}/PIC32CM1216MC00032" ${PACK_COMMON_OPTIONS} 
+	
 endif
 
 # ------------------------------------------------------------------------------------
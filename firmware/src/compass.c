@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/** compass
+
+  @Company
+    Schindelar
+
+  @File Name
+    compass.c
+
+  @Summary
+    Direction of the drone from the azimuths of the satellites in view. Every
+    azimuth is added as a unit vector with the linear power of its signal as
+    weight, the power comes from a table by the dB below the strongest
+    satellite, so no pow() and no floating point is needed. The angle of the
+    mean vector is turned by the magnetic declination.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "compass.h"
+#include "geo.h"
+#include "trig.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//the azimuths of the satellites are full degrees, so the CORDIC tier with
+//0.1 degrees is enough for the unit vectors
+#define COMPASS_TRIG_TIER TRIG_TIER_0_1
+
+//linear power of a satellite as Q16 by the dB below the strongest satellite,
+//it is 10^(-dB/10). Satellites 50 dB or more below the strongest are not
+//counted anymore
+static const uint16_t compass_signal_weight[50] = {
+    65535, 52057, 41350, 32846, 26090, 20724, 16462, 13076, 10387,  8250,
+     6554,  5206,  4135,  3285,  2609,  2072,  1646,  1308,  1039,   825,
+      655,   521,   414,   328,   261,   207,   165,   131,   104,    83,
+       66,    52,    41,    33,    26,    21,    16,    13,    10,     8,
+        7,     5,     4,     3,     3,     2,     2,     1,     1,     1,
+};
+
+#define COMPASS_WEIGHTS (sizeof(compass_signal_weight) \
+        / sizeof(compass_signal_weight[0]))
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function calculates the cardinal direction of the drone from the
+//satellites in view in 1/100 degrees from 0 to 35999 with the magnetic
+//declination, it returns -1 when no satellite has a strong enough signal
+int32_t compass_direction(const gps_satellite_table_t* satellites) {
+    int64_t sum_north = 0;
+    int64_t sum_east = 0;
+    int8_t strongest = 0;
+    uint8_t used_satellites = 0;
+
+    //the weights are relative to the strongest satellite, so they fit into
+    //the table without the range of the absolute power
+    for(uint8_t i = 0; i < satellites->count; i++) {
+        if(satellites->satellite[i].signal_strength > strongest) {
+            strongest = satellites->satellite[i].signal_strength;
+        }
+    }
+
+    //every azimuth is added as a unit vector with the linear signal power
+    //as weight, so the azimuths around north do not cancel each other out
+    for(uint8_t i = 0; i < satellites->count; i++) {
+        const gps_satellite_t* satellite = &satellites->satellite[i];
+        if(satellite->signal_strength < COMPASS_MIN_SIGNAL) {
+            continue;
+        }
+
+        uint8_t below = (uint8_t)(strongest - satellite->signal_strength);
+        int32_t weight = (below < COMPASS_WEIGHTS) ?
+                compass_signal_weight[below] : 0;
+        int32_t sin, cos;
+        trig_sin_cos(trig_from_centidegrees(satellite->azimuth * 100L),
+                COMPASS_TRIG_TIER, &sin, &cos);
+
+        //the unit vector is shifted from Q30 into Q15
+        sum_north += (int64_t)weight * (cos >> 15);
+        sum_east += (int64_t)weight * (sin >> 15);
+        used_satellites++;
+    }
+
+    if(used_satellites == 0) {
+        return -1;
+    }
+
+    //the sums are shifted down into 32 bits for the atan2, the direction
+    //stays the same
+    while(sum_north > INT32_MAX || sum_north < -INT32_MAX
+            || sum_east > INT32_MAX || sum_east < -INT32_MAX) {
+        sum_north /= 2;
+        sum_east /= 2;
+    }
+
+    //the angle of the mean vector is turned by the declination and wrapped
+    //into 0 to 35999 for both signs of the declination
+    int32_t direction = (int32_t)geo_atan2((int32_t)sum_east,
+            (int32_t)sum_north) + COMPASS_DECLINATION;
+    if(direction >= 36000) {
+        direction -= 36000;
+    } else if(direction < 0) {
+        direction += 36000;
+    }
+    return direction;
+}
+
+/* *****************************************************************************
+ End of File
+ */
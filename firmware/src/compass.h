@@ -0,0 +1,41 @@
+/* ************************************************************************** */
+/** compass
+
+  @Company
+    Schindelar
+
+  @File Name
+    compass.h
+
+  @Summary
+    Direction of the drone from the azimuths of the satellites in view,
+    weighted with the linear power of their signals, in integer 1/100
+    degrees
+ */
+/* ************************************************************************** */
+
+#ifndef _COMPASS_H    /* Guard against multiple inclusion */
+#define _COMPASS_H
+
+#include <stdint.h>
+#include "gps.h"
+
+//magnetic declination of the HTL in 1/100 degrees, east is positive. It can
+//be between -18000 and 18000 and can be set with -DCOMPASS_DECLINATION
+#ifndef COMPASS_DECLINATION
+#define COMPASS_DECLINATION 505
+#endif
+
+//satellites with a weaker signal in dB are not used
+#define COMPASS_MIN_SIGNAL 10
+
+//this function calculates the cardinal direction of the drone from the
+//satellites in view in 1/100 degrees from 0 to 35999 with the magnetic
+//declination, it returns -1 when no satellite has a strong enough signal
+int32_t compass_direction(const gps_satellite_table_t* satellites);
+
+#endif /* _COMPASS_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,188 @@
+/* ************************************************************************** */
+/** control_tick
+
+  @Company
+    Schindelar
+
+  @File Name
+    control_tick.c
+
+  @Summary
+    Fixed rate control tick from TC0. TC0 counts with the cpu clock divided
+    by 64 in the match frequency mode, so the period does not drift with the
+    interrupt latency. The interrupt counts the tick and a miss when the
+    control step of the last tick has not started yet, the lateness of the
+    start is measured in the main loop and sorted into the histogram.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "definitions.h"
+#include "control_tick.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//clock of TC0 after the prescaler in Hz
+#define CONTROL_TICK_CLOCK (CPU_CLOCK_FREQUENCY / 64)
+
+//upper limits of the lateness classes in microseconds, the last class has
+//no limit
+static const uint32_t control_tick_limits[CONTROL_TICK_BINS - 1] = {
+    50, 100, 200, 500, 1000, 2000, 5000,
+};
+
+//rate of the tick in Hz
+static uint16_t control_tick_rate = CONTROL_TICK_RATE_HZ;
+
+//system time of the last tick in microseconds, true when the tick has not
+//been taken by the main loop yet and true when the control step of the last
+//tick has started
+static volatile uint32_t control_tick_us = 0;
+static volatile bool control_tick_new = false;
+static volatile bool control_tick_started = true;
+
+//statistic of the tick
+static volatile control_tick_stats_t control_tick_stats;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interrupt                                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//the TC0 handler replaces the Dummy_Handler alias from interrupts.c, it is
+//called at every overflow of TC0
+void TC0_Handler(void) {
+    TC0_REGS->COUNT16.TC_INTFLAG = TC_INTFLAG_OVF_Msk;
+
+    control_tick_stats.ticks++;
+    if(!control_tick_started) {
+        control_tick_stats.misses++;
+    }
+    control_tick_us = systime_get_us();
+    control_tick_new = true;
+    control_tick_started = false;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function starts TC0 with an interrupt at the rate in Hz, the rate is
+//limited to CONTROL_TICK_MIN_HZ and CONTROL_TICK_MAX_HZ
+void control_tick_initialize(uint16_t rate_hz) {
+    if(rate_hz < CONTROL_TICK_MIN_HZ) {
+        rate_hz = CONTROL_TICK_MIN_HZ;
+    } else if(rate_hz > CONTROL_TICK_MAX_HZ) {
+        rate_hz = CONTROL_TICK_MAX_HZ;
+    }
+    control_tick_rate = rate_hz;
+    control_tick_new = false;
+    control_tick_started = true;
+    control_tick_reset_stats();
+
+    //TC0 counts from 0 to CC0 and starts again at 0, the overflow is the
+    //tick. The clock of TC0 is already enabled by the clock library
+    TC0_REGS->COUNT16.TC_CTRLA = TC_CTRLA_SWRST_Msk;
+    while(TC0_REGS->COUNT16.TC_SYNCBUSY & TC_SYNCBUSY_SWRST_Msk);
+    TC0_REGS->COUNT16.TC_CTRLA = TC_CTRLA_MODE_COUNT16
+            | TC_CTRLA_PRESCALER_DIV64 | TC_CTRLA_PRESCSYNC_PRESC;
+    TC0_REGS->COUNT16.TC_WAVE = (uint8_t)TC_WAVE_WAVEGEN_MFRQ;
+    TC0_REGS->COUNT16.TC_CC[0] = (uint16_t)(CONTROL_TICK_CLOCK / rate_hz - 1);
+    while(TC0_REGS->COUNT16.TC_SYNCBUSY & TC_SYNCBUSY_CC0_Msk);
+    TC0_REGS->COUNT16.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+    TC0_REGS->COUNT16.TC_INTENSET = TC_INTENSET_OVF_Msk;
+    TC0_REGS->COUNT16.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+    while(TC0_REGS->COUNT16.TC_SYNCBUSY & TC_SYNCBUSY_ENABLE_Msk);
+
+    NVIC_SetPriority(TC0_IRQn, 3);
+    NVIC_EnableIRQ(TC0_IRQn);
+}
+
+//this function returns the rate of the control tick in Hz
+uint16_t control_tick_get_rate(void) {
+    return control_tick_rate;
+}
+
+//this function returns true once for every new tick, the main loop releases
+//the control tasks with it
+bool control_tick_take(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool taken = control_tick_new;
+    control_tick_new = false;
+
+    __set_PRIMASK(primask);
+    return taken;
+}
+
+//this function returns true when there is a tick which has not been taken
+//yet, it does not take the tick
+bool control_tick_is_pending(void) {
+    return control_tick_new;
+}
+
+//this function is called at the start of the control step, it measures the
+//time since the tick
+void control_tick_start(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    //the step of this tick has already started or there was no tick yet
+    if(control_tick_started) {
+        __set_PRIMASK(primask);
+        return;
+    }
+    uint32_t tick_us = control_tick_us;
+    control_tick_started = true;
+
+    __set_PRIMASK(primask);
+
+    uint32_t lateness = systime_get_us() - tick_us;
+    if(lateness > control_tick_stats.max_lateness_us) {
+        control_tick_stats.max_lateness_us = lateness;
+    }
+
+    uint8_t bin = 0;
+    while(bin < CONTROL_TICK_BINS - 1 && lateness > control_tick_limits[bin]) {
+        bin++;
+    }
+    control_tick_stats.histogram[bin]++;
+}
+
+//this function returns the statistic of the control tick
+const control_tick_stats_t* control_tick_get_stats(void) {
+    return (const control_tick_stats_t*)&control_tick_stats;
+}
+
+//this function resets the statistic of the control tick
+void control_tick_reset_stats(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    control_tick_stats.ticks = 0;
+    control_tick_stats.misses = 0;
+    control_tick_stats.max_lateness_us = 0;
+    for(uint8_t i = 0; i < CONTROL_TICK_BINS; i++) {
+        control_tick_stats.histogram[i] = 0;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/* *****************************************************************************
+ End of File
+ */
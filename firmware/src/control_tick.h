@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/** control_tick
+
+  @Company
+    Schindelar
+
+  @File Name
+    control_tick.h
+
+  @Summary
+    Fixed rate control tick from TC0. The interrupt only marks the tick, the
+    main loop releases the control tasks with it and the statistic shows
+    how late and how often too late the control step started
+ */
+/* ************************************************************************** */
+
+#ifndef _CONTROL_TICK_H    /* Guard against multiple inclusion */
+#define _CONTROL_TICK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//rate of the control tick in Hz, TC0 runs with 750 kHz, so the rate can be
+//between CONTROL_TICK_MIN_HZ and CONTROL_TICK_MAX_HZ
+#define CONTROL_TICK_RATE_HZ 50
+#define CONTROL_TICK_MIN_HZ 12
+#define CONTROL_TICK_MAX_HZ 1000
+
+//amount of classes of the lateness histogram, the upper limits of the
+//classes are 50, 100, 200, 500, 1000, 2000 and 5000 us, the last class
+//takes all later starts
+#define CONTROL_TICK_BINS 8
+
+//statistic of the control tick since the last reset
+typedef struct {
+    uint32_t ticks;             //amount of ticks of TC0
+    uint32_t misses;            //ticks which came before the control step
+                                //of the tick before had started
+    uint32_t max_lateness_us;   //latest start of a control step after its
+                                //tick
+    uint32_t histogram[CONTROL_TICK_BINS];  //starts in every lateness class
+} control_tick_stats_t;
+
+//this function starts TC0 with an interrupt at the rate in Hz, the rate is
+//limited to CONTROL_TICK_MIN_HZ and CONTROL_TICK_MAX_HZ
+void control_tick_initialize(uint16_t rate_hz);
+
+//this function returns the rate of the control tick in Hz
+uint16_t control_tick_get_rate(void);
+
+//this function returns true once for every new tick, the main loop releases
+//the control tasks with it
+bool control_tick_take(void);
+
+//this function returns true when there is a tick which has not been taken
+//yet, it does not take the tick
+bool control_tick_is_pending(void);
+
+//this function is called at the start of the control step, it measures the
+//time since the tick
+void control_tick_start(void);
+
+//this function returns the statistic of the control tick
+const control_tick_stats_t* control_tick_get_stats(void);
+
+//this function resets the statistic of the control tick
+void control_tick_reset_stats(void);
+
+#endif /* _CONTROL_TICK_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,192 @@
+/* ************************************************************************** */
+/** divas_math
+
+  @Company
+    Schindelar
+
+  @File Name
+    divas_math.c
+
+  @Summary
+    Integer division and square root with the DIVAS hardware unit. The Cortex
+    M0+ has no divide instruction, so every division of the compiler calls
+    a function of libgcc which needs several hundred cycles. The DIVAS needs
+    2 to 16 cycles for a division and the square root. The division functions
+    of the compiler are not replaced, the arithmetic of the control path calls
+    the functions here explicitly and the benchmark compares both at the start.
+    The DIVAS has only one set of registers, so every operation runs with
+    the interrupts disabled, then an interrupt can not change the registers
+    between the write of the operands and the read of the result.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "definitions.h"
+#include "divas_math.h"
+#include "geo.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of operations of every kind in the benchmark, all of them together
+//have to fit into one millisecond period of the SysTick
+#define DIVAS_BENCHMARK_COUNT 32
+
+//cycles of one operation measured by divas_benchmark
+static divas_benchmark_t divas_benchmark_result;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function runs one division on the DIVAS and returns the quotient in
+//the lower and the remainder in the upper word
+static uint64_t divas_run_division(uint32_t dividend, uint32_t divisor,
+        uint8_t control) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    //the write of the divisor starts the division
+    DIVAS_REGS->DIVAS_CTRLA = control;
+    DIVAS_REGS->DIVAS_DIVIDEND = dividend;
+    DIVAS_REGS->DIVAS_DIVISOR = divisor;
+    while(DIVAS_REGS->DIVAS_STATUS & DIVAS_STATUS_BUSY_Msk);
+
+    uint32_t quotient = DIVAS_REGS->DIVAS_RESULT;
+    uint32_t remainder = DIVAS_REGS->DIVAS_REM;
+
+    //a division by 0 sets the DBZ flag, it is cleared by writing a one
+    DIVAS_REGS->DIVAS_STATUS = DIVAS_STATUS_DBZ_Msk;
+    __set_PRIMASK(primask);
+
+    return ((uint64_t)remainder << 32) | quotient;
+}
+
+//this function returns the cpu cycles since the SysTick value start, the
+//SysTick counts down with the cpu clock and may have wrapped once
+static uint32_t divas_cycles_since(uint32_t start) {
+    uint32_t end = SysTick->VAL;
+
+    if(end <= start) {
+        return start - end;
+    }
+    return start + (SysTick->LOAD + 1) - end;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function switches on the clock of the DIVAS
+void divas_initialize(void) {
+    MCLK_REGS->MCLK_AHBMASK |= MCLK_AHBMASK_DIVAS_Msk;
+    DIVAS_REGS->DIVAS_CTRLA = 0;
+}
+
+//this function divides two signed numbers, the result is rounded towards 0
+//and it is 0 when the divisor is 0
+int32_t divas_divide(int32_t dividend, int32_t divisor) {
+    return (int32_t)(uint32_t)divas_run_division((uint32_t)dividend,
+            (uint32_t)divisor, DIVAS_CTRLA_SIGNED_Msk);
+}
+
+//this function divides two unsigned numbers, the result is rounded down and
+//it is 0 when the divisor is 0
+uint32_t divas_udivide(uint32_t dividend, uint32_t divisor) {
+    return (uint32_t)divas_run_division(dividend, divisor, 0);
+}
+
+//this function calculates the square root of an unsigned number, the result
+//is rounded down
+uint32_t divas_sqrt(uint32_t value) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    //the write of the number starts the square root, it is always unsigned
+    DIVAS_REGS->DIVAS_SQRNUM = value;
+    while(DIVAS_REGS->DIVAS_STATUS & DIVAS_STATUS_BUSY_Msk);
+    uint32_t root = DIVAS_REGS->DIVAS_RESULT;
+
+    __set_PRIMASK(primask);
+    return root;
+}
+
+//this function measures the cpu cycles of one division with the DIVAS, of
+//one division with the "/" of the compiler, which calls the software
+//division of libgcc, of one square root with the DIVAS and of one square
+//root bit by bit in software. The operands are volatile, so the compiler can
+//not calculate the results before
+void divas_benchmark(void) {
+    volatile uint32_t dividend = 0xDEADBEEFUL;
+    volatile uint32_t divisor = 12345;
+    volatile uint32_t result;
+
+    //the interrupts are disabled, so only the operations are counted
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t start = SysTick->VAL;
+    for(uint8_t i = 0; i < DIVAS_BENCHMARK_COUNT; i++) {
+        result = dividend + divisor;
+    }
+    uint32_t loop = divas_cycles_since(start);
+
+    start = SysTick->VAL;
+    for(uint8_t i = 0; i < DIVAS_BENCHMARK_COUNT; i++) {
+        result = divas_udivide(dividend, divisor);
+    }
+    uint32_t divas = divas_cycles_since(start);
+
+    start = SysTick->VAL;
+    for(uint8_t i = 0; i < DIVAS_BENCHMARK_COUNT; i++) {
+        result = dividend / divisor;
+    }
+    uint32_t libgcc = divas_cycles_since(start);
+
+    start = SysTick->VAL;
+    for(uint8_t i = 0; i < DIVAS_BENCHMARK_COUNT; i++) {
+        result = divas_sqrt(dividend);
+    }
+    uint32_t root = divas_cycles_since(start);
+
+    start = SysTick->VAL;
+    for(uint8_t i = 0; i < DIVAS_BENCHMARK_COUNT; i++) {
+        result = geo_isqrt_bits(dividend);
+    }
+    uint32_t bits = divas_cycles_since(start);
+
+    __set_PRIMASK(primask);
+    (void)result;
+
+    //the cycles of the loop with the load and the store are subtracted
+    divas_benchmark_result.divas_cycles = (uint16_t)divas_udivide(
+            divas - loop, DIVAS_BENCHMARK_COUNT);
+    divas_benchmark_result.libgcc_cycles = (uint16_t)divas_udivide(
+            libgcc - loop, DIVAS_BENCHMARK_COUNT);
+    divas_benchmark_result.sqrt_cycles = (uint16_t)divas_udivide(
+            root - loop, DIVAS_BENCHMARK_COUNT);
+    divas_benchmark_result.bits_cycles = (uint16_t)divas_udivide(
+            bits - loop, DIVAS_BENCHMARK_COUNT);
+}
+
+//this function returns the result of the last benchmark, it is 0 before the
+//first benchmark
+const divas_benchmark_t* divas_get_benchmark(void) {
+    return &divas_benchmark_result;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/** divas_math
+
+  @Company
+    Schindelar
+
+  @File Name
+    divas_math.h
+
+  @Summary
+    Integer division and square root with the DIVAS hardware unit, safe to
+    call from the main loop and from interrupts
+ */
+/* ************************************************************************** */
+
+#ifndef _DIVAS_MATH_H    /* Guard against multiple inclusion */
+#define _DIVAS_MATH_H
+
+#include <stdint.h>
+
+//cpu cycles of one operation, measured with the SysTick
+typedef struct {
+    uint16_t divas_cycles;      //unsigned division with the DIVAS
+    uint16_t libgcc_cycles;     //unsigned division with the "/" of libgcc
+    uint16_t sqrt_cycles;       //square root with the DIVAS
+    uint16_t bits_cycles;       //square root bit by bit with geo_isqrt_bits
+} divas_benchmark_t;
+
+//this function switches on the clock of the DIVAS
+void divas_initialize(void);
+
+//this function divides two signed numbers, the result is rounded towards 0
+//and it is 0 when the divisor is 0
+int32_t divas_divide(int32_t dividend, int32_t divisor);
+
+//this function divides two unsigned numbers, the result is rounded down and
+//it is 0 when the divisor is 0
+uint32_t divas_udivide(uint32_t dividend, uint32_t divisor);
+
+//this function calculates the square root of an unsigned number, the result
+//is rounded down
+uint32_t divas_sqrt(uint32_t value);
+
+//this function measures the cpu cycles of one division with the DIVAS, of
+//one division with the "/" of the compiler, which calls the software
+//division of libgcc, of one square root with the DIVAS and of one square
+//root bit by bit in software. The operands are volatile, so the compiler can
+//not calculate the results before
+void divas_benchmark(void);
+
+//this function returns the result of the last benchmark, it is 0 before the
+//first benchmark
+const divas_benchmark_t* divas_get_benchmark(void);
+
+#endif /* _DIVAS_MATH_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -20,11 +20,26 @@
 
 #include <stdbool.h>
 #include <stdio.h>
-#include <math.h>
 #include <string.h>
 #include <stdlib.h>
 #include "definitions.h"
 #include "flugprotokoll.h"
+#include "gps.h"
+#include "systime.h"
+#include "uart_line.h"
+#include "hotstart.h"
+#include "geo.h"
+#include "pid.h"
+#include "predictor.h"
+#include "heading.h"
+#include "compass.h"
+#include "nmea.h"
+#include "timer.h"
+#include "scheduler.h"
+#include "control_tick.h"
+#include "power.h"
+#include "divas_math.h"
+#include "geo_benchmark.h"
 
 /* ************************************************************************** */
 /* ************************************************************************** */
@@ -32,15 +47,21 @@
 /* ************************************************************************** */
 /* ************************************************************************** */
 
-#define TWO_PI 2*M_PI   //defines two pi for the calculation
-#define latitude_distance 111.19494     //defines the exact distance between two latitudes
-#define one_degree_in_radians 0.01745   //defines one degree in radians 
-#define delta_limited_high 3    //defines the maximum distancen for the altitude as deviation from the the start altitude high
-#define max_weight 3.0    //this is the max weight which the load cell allows
-#define magnetic_declination 5.05   //define the magnetic declination of the HTL
+#define delta_limited_high 3000    //flight high above the start in mm
+#define max_weight 3000    //this is the max weight in grams for the load cell
 
-//this defines a tolerance range for the cardinal direction
-#define compass_tolerance 2.0
+//this defines a tolerance range for the cardinal direction in 1/100 degrees
+#define compass_tolerance 200
+
+//heading error in 1/100 degrees from which on the yaw command is at the
+//maximum, below it the yaw command is proportional to the error
+#define yaw_full_error 4500
+
+//with the course over ground as heading the drone flies forward with this
+//pitch during the alignment, the forward pulse before the alignment lasts
+//at most the pulse time in milliseconds
+#define pitch_course_value 1600
+#define heading_pulse_ms 3000
 
 //define for each roll, pitch, yaw and throttle value the middle, max, min value
 //the whole flight process does not need the roll so roll is always at 1500
@@ -58,6 +79,116 @@
 #define throttle_max_value 1750
 #define throttle_min_value 1250
 
+//the roll is only used to correct the cross track error during the flight
+//along the leg, so its range is smaller
+#define roll_max_value 1650
+#define roll_min_value 1350
+
+//distance to the end position in centimetres where the leg is finished
+#define arrival_tolerance 20
+
+//the climb is finished when the altitude is inside this tolerance and the
+//vertical speed below the settle speed, the landing is finished at the
+//landing high above the ground, all in millimetres and millimetres per
+//second
+#define altitude_tolerance 200
+#define altitude_settle_speed 200
+#define landing_high 50
+
+//limits of the vertical speed in millimetres per second, below the slow
+//descent high above the ground the drone lands slower
+#define climb_speed 1000
+#define descent_speed 1000
+#define slow_descent_speed 300
+#define slow_descent_high 1000
+
+//the drone needs more throttle when it is tilted by the pitch, this is the
+//throttle per pitch as Q8, 256 is the same value
+#define pitch_throttle_feed_forward 256
+
+//the output task sends the last command to the flight controller again
+//when there was no new command for this time in milliseconds
+#define command_refresh_ms 100
+
+//waits of the flight process in milliseconds, the overweight message is
+//repeated after the first one, on the ground the package can be taken out
+//during the second one and the third one ends the flight process
+#define overweight_wait_ms 3000
+#define unload_wait_ms 120000
+#define end_of_flight_wait_ms 10000
+
+//indices of the controllers in the parameter table
+#define control_along_track 0
+#define control_cross_track 1
+#define control_altitude 2
+#define control_vertical_speed 3
+#define control_count 4
+
+//states of the flight state machine, the setup states run once before the
+//flight and the states from the climb to the landing are the phases of one
+//leg, they are flown for the outbound leg and again for the return leg
+#define state_coordinates 0
+#define state_start_position 1
+#define state_payload 2
+#define state_compass 3
+#define state_start_signal 4
+#define state_climb 5
+#define state_calibrate 6
+#define state_align 7
+#define state_leg 8
+#define state_descend 9
+#define state_ground 10
+#define state_return_position 11
+#define state_return_payload 12
+#define state_end 13
+#define state_count 14
+
+//events of the flight state machine as bits, they are collected once in
+//every run of the navigation task and given to the step of the state
+#define event_fix 0x01          //a new gps fix
+#define event_satellites 0x02   //a new group of satellite sentences
+#define event_timer 0x04        //the wait with TIMER_STATE has run out
+#define event_bluetooth 0x08    //a new line from the bluetooth task
+
+//the messages to the bluetooth modul wait in a queue until the bluetooth
+//task can send them, the count is a power of two for the free running
+//indices
+#define bluetooth_queue_count 8
+#define bluetooth_queue_length 100
+
+//indices of the legs in the leg parameter table
+#define leg_outbound 0
+#define leg_return 1
+#define leg_count 2
+
+//lines of the report, one for every task and every state of the flight
+//process, two for the control tick, one for the sleep, one for the cycles
+//of the division, one for the cycles of the geodesy and the load of all
+//tasks with the lost bluetooth messages at the end
+#define report_tick_line (SCHEDULER_TASK_COUNT + state_count)
+#define report_power_line (report_tick_line + 2)
+#define report_divas_line (report_power_line + 1)
+#define report_geo_line (report_power_line + 2)
+#define report_lines (report_power_line + 4)
+
+//handlers of one state of the flight process. The enter handler runs once
+//when the state starts and the exit handler once when it ends, the step
+//handler runs in every pass with the events and returns the next state.
+//None of them waits, so every pass returns to the main loop
+typedef struct {
+    const char* name;               //name of the state in the report
+    void (*enter)(void);            //NULL when there is nothing to start
+    uint8_t (*step)(uint8_t events);
+    void (*exit)(void);             //NULL when there is nothing to end
+} flight_state_t;
+
+//parameters of the leg phases which differ between the outbound leg and
+//the return leg
+typedef struct {
+    uint32_t ground_wait_ms;    //wait on the ground after the landing
+    uint8_t after_ground;       //state after the wait on the ground
+} leg_parameter_t;
+
 /* ************************************************************************** */
 /* ************************************************************************** */
 /* Section: Variables Area                                                    */
@@ -66,45 +197,120 @@
 
 //ALL CALLED SERCOM, TC FUNCTIONS are functions of the PIC Libraries
 
-//this doubles are for the value which will be set in the setup process
-double start_lat, start_lon, end_lat, end_lon, altitude_start_position;
-double himmelsrichtung, entfernung;
-double payload = 0;     //define a double variable as payload
-
-double azimuth = 0;
-
-//Create a double variable for the return at read_distance
+//altitude of the start position of the current leg in millimetres and the
+//weight of the payload from the load cell in grams
+int32_t start_altitude = 0;
+int32_t payload = 0;
 
-//for the switch case function the variable will define the current state
-//in the fly process
-char process_state = 0;
+//start and end position of the current leg in 1e-7 degrees and the north
+//east frame of the leg, so every fix can be moved into the frame of the leg
+//without floating point
+int32_t start_latitude, start_longitude, end_latitude, end_longitude;
+geo_leg_t flight_leg;
 
-//this variable is for the switch case function of the setup process
-char setup_state = 0;
+//for the state machine the variable defines the current state in the fly
+//process, the enter handler of the state has run when entered is true
+uint8_t flight_state = state_coordinates;
+bool flight_state_entered = false;
 
-//This variable is for the switch case function of the setup process at the back
-//flight
-char backflight_setup_state = 0;
+//table of the states, it is defined at the end of the file after the
+//handlers
+extern const flight_state_t flight_states[state_count];
 
-//this variable is for the switch case function of the takeoff process
-char takeoff_process = 0;
+//longest pass of every state with the enter, step and exit handlers in
+//microseconds, it is the worst case step time of the flight process
+uint32_t flight_state_max_us[state_count];
 
-//this variable is for the switch case funtion of the backflight takeoff process
-char backflight_takeoff_process = 0;
+//the leg which is flown at the moment and the parameters of both legs, on
+//the ground at the end position the package can be taken out and at the
+//start position the flight process ends
+uint8_t current_leg = leg_outbound;
+const leg_parameter_t leg_parameter[leg_count] = {
+    {unload_wait_ms, state_return_position},  //outbound leg
+    {end_of_flight_wait_ms, state_end},       //return leg
+};
 
 //this variables define how the uart messages has to start, so the program knows
 //which message it has to edit during the fly and setup process
 const char* coords_prefix = "$COORDS"; 
-const char* gps_prefix = "$GNGGA,";
-const char* satelite_prefix = "$GPGSV";
 
 //will be set everytime when a gps message comes in and is required
 //because is the value less than 8 the coords will not be exactly
 int satelites_connected = 0;
 
+//sequence number of the last used gps fix and epoch of the last used
+//satellite table, with them the program knows if there is a new sample or
+//the same sample again
+uint32_t flight_fix_sequence = 0;
+uint32_t satelite_epoch = 0;
+
+//the distance to the end position and the cross track error of the fix with
+//the distance_sequence in centimetres, so they are calculated just once for
+//every fix
+uint32_t distance_sequence = 0;
+uint32_t current_distance = 0;
+int32_t current_along_track = 0;
+int32_t current_cross_track = 0;
+
+//parameter table of the position controllers, the errors are in
+//centimetres and the outputs are the offsets of the pitch and roll in
+//microseconds, the gains are Q8
+const pid_parameter_t control_parameter[control_count] = {
+    //kp, ki, kd, integral limit, output min, output max
+    {51, 3, 51, 5000, pitch_min_value - pitch_middle_value,
+            pitch_max_value - pitch_middle_value},  //along track to pitch
+    {128, 0, 77, 0, roll_min_value - roll_value,
+            roll_max_value - roll_value},           //cross track to roll
+    {256, 0, 0, 0, -descent_speed, climb_speed},    //altitude in mm to the
+                                                    //vertical speed in mm/s
+    {26, 13, 0, 5000, throttle_min_value - throttle_middle_value,
+            throttle_max_value - throttle_middle_value},//vertical speed
+                                                    //to throttle
+};
+pid_state_t control_state[control_count];
+
+//position and velocity of the drone in the frame of the leg, it gives the
+//position controller a new estimate at every control tick
+predictor_t leg_predictor;
+
+//result of the last leg, the time from the start to the arrival in
+//milliseconds, the distance and the cross track error at the arrival and
+//the biggest cross track error during the leg in centimetres
+uint32_t leg_time_ms = 0;
+uint32_t leg_final_distance = 0;
+int32_t leg_final_cross_track = 0;
+uint32_t leg_max_cross_track = 0;
+
+//start time of the leg and time of the last control tick in milliseconds
+uint32_t leg_start_ms = 0;
+uint32_t leg_tick_ms = 0;
+
+//altitude estimate from the fixes, the altitude of the last fix in
+//millimetres, the vertical speed in millimetres per second with upwards
+//positive and the time of the last fix in milliseconds
+int32_t current_altitude = 0;
+int32_t current_vertical_speed = 0;
+uint32_t altitude_fix_ms = 0;
+
+//target altitude of the altitude hold during the flight along the leg in
+//millimetres, it is set at the end of the climb
+int32_t hold_altitude = 0;
+
+//result of the last climb or descent, the time in milliseconds and the
+//biggest altitude beyond the target in millimetres
+uint32_t altitude_phase_ms = 0;
+uint32_t altitude_overshoot = 0;
+
+//the running climb or descent, the target altitude in millimetres, if it is
+//the landing or a climb, the start time and the time of the last fix
+int32_t altitude_target = 0;
+bool altitude_landing = false;
+bool altitude_climbing = false;
+uint32_t altitude_start_ms = 0;
+uint32_t altitude_last_fix_ms = 0;
+
 //this messages are strings for the incoming messages from all uarts
 uint8_t receive_bt[250] = "";
-uint8_t receive_gps[250] = "";
 uint8_t receive_load_cell[250] = "";
 
 //message to send to the bluetooth modul to tell the user,
@@ -119,19 +325,99 @@ uint8_t message_ready_to_start[100] = "Die Drohne ist bereit zum abfliegen!";
 //that the flight is starting now
 uint8_t message_fly_starts[100] = "Der Flug startet jetzt!";
 
+//message to send to the bluetooth modul to tell the user the time to the
+//first fix, to 8 satellites and the age of the hot start position
+uint8_t message_gps_start[100] = "";
+
+//message to send to the bluetooth modul to tell the user the baud rate,
+//the reached update rate of the gps modul and the state of the PPS
+uint8_t message_gps_status[100] = "";
+
+//message to send to the bluetooth modul to tell the user how long the
+//alignment to the direction of the leg took and how far it overshot
+uint8_t message_alignment[100] = "";
+
+//message to send to the bluetooth modul to tell the user the update rate
+//and the convergence time of the heading after the forward pulse
+uint8_t message_heading[100] = "";
+
+//prefix of the bluetooth message which selects the source of the heading,
+//"$HEADING,COG" for the course over ground and "$HEADING,SAT" for the
+//azimuths of the satellites
+const char* heading_prefix = "$HEADING";
+
+//result of the last alignment, the time in milliseconds and the biggest
+//error to the other side of the direction in 1/100 degrees
+uint32_t alignment_time_ms = 0;
+uint16_t alignment_overshoot = 0;
+
+//the running alignment, the pitch during it, the error of the first
+//heading and if the first heading is still missing
+uint16_t alignment_pitch = pitch_middle_value;
+int32_t alignment_first_error = 0;
+bool alignment_first_sample = true;
+
+//start time of the running alignment in milliseconds
+uint32_t phase_start_ms = 0;
+
+//message to send to the bluetooth modul to tell the user how long the climb
+//or descent took and how far it overshot the target altitude
+uint8_t message_altitude[100] = "";
+
+//message to send to the bluetooth modul to tell the user how long the leg
+//took and how precise the drone arrived
+uint8_t message_leg[100] = "";
+
 //tihs variable is to fill in the roll, pitch, yaw and throttle value
-//which will be send over uart to the flight controller
+//which will be send over uart to the flight controller, the output task
+//copies it into the transmit buffer, so a new command can not change the
+//one which is sent at the moment
 uint8_t message_to_fly_controller[100] = "";
+uint8_t transmit_fly_controller[100] = "";
 
 //message for the comparison with the income bluetooth start message and the 
 //start signal to be sure it is the right message to start
 uint8_t start_signal[100] = "$FLYSTART";
 
-//the empty_string variable is for the comparison with the income bluetooth 
-//message over uart.
-//this is necessary, because the uart from bluetooth does not send a message
-//the whole time, just when the user send something over with the phone.
-uint8_t empty_string[250] = "";
+//time from the end of the gps sentence of the used fix to the last message
+//to the flight controller in microseconds
+uint32_t decision_latency_us = 0;
+
+//true when there is a new command in message_to_fly_controller which has
+//not been sent yet, without one the last command is sent again when
+//TIMER_COMMAND_REFRESH runs out
+bool command_pending = false;
+
+//true when the bluetooth task has put a new line into receive_bt which has
+//not been used by the setup yet
+bool bluetooth_line_ready = false;
+
+//prefix of the bluetooth message which asks for the report of the tasks
+const char* stats_prefix = "$STATS";
+
+//line of the report, the report is sent one line after the other by the
+//bluetooth task, the index is report_lines when there is no report to send
+uint8_t message_report[100] = "";
+uint8_t report_index = report_lines;
+
+//status message of the logging task
+uint8_t message_log[100] = "";
+
+//queue of the messages to the bluetooth modul, the handlers write at the
+//write index and the bluetooth task sends at the read index, the message
+//which is sent at the moment is copied into the transmit buffer. The lost
+//messages did not fit into the full queue
+uint8_t bluetooth_queue[bluetooth_queue_count][bluetooth_queue_length];
+uint8_t bluetooth_write_index = 0;
+uint8_t bluetooth_read_index = 0;
+uint8_t bluetooth_transmit[bluetooth_queue_length] = "";
+uint32_t bluetooth_lost = 0;
+
+//true while the load cell task waits for the end of the I2C transfer and
+//true while the flight process checks the payload, only then the load cell
+//is read and its SERCOM has a clock
+bool load_cell_busy = false;
+bool load_cell_needed = false;
 
 //this variable is required at each new setup run to exit the setup
 bool setup_complete = false;
@@ -146,46 +432,27 @@ bool flight_process = false;
 /* ************************************************************************** */
 /* ************************************************************************** */
 
-//this function creates any milliseconds delay
-//useful to make sure that a function has been completed 
-//or to introduce a delay in the program flow.
-void delay_ms(uint16_t ms) {
-    uint16_t t;
-    for(t=0;t<ms;t++) {
-        TC0_TimerStart();
-        while(!TC0_TimerPeriodHasExpired());
-        TC0_TimerStop();
-    }
-}
-
-//this function creates any microseconds delay
-//useful to make sure that a function has been completed 
-//or to introduce a delay in the program flow.
-void delay_us(uint16_t us) {
-    uint16_t t;
-    for(t=0;t<us;t++) {
-        TC1_TimerStart();
-        while(!TC1_TimerPeriodHasExpired());
-        TC1_TimerStop();
-    }
-}
-
 //this function resets all necessary variables for a restart flight process
 //and also to start a new process
 void change_flugprozess_variable(void) {
     
     //Change some variables for a restart
-    process_state = 0;
-    setup_state = 0;
+    flight_state = state_coordinates;
+    flight_state_entered = false;
+    current_leg = leg_outbound;
+    load_cell_needed = false;
     satelites_connected = 0;
+    distance_sequence = 0;
     payload = 0;
-    takeoff_process = 0;
-    backflight_setup_state = 0;
-    backflight_takeoff_process = 0;
+    
+    //a wait which is still running belongs to the old flight process
+    timer_stop(TIMER_STATE);
+    timer_stop(TIMER_OVERWEIGHT);
+    timer_stop(TIMER_COMMAND_REFRESH);
+    command_pending = false;
     
     //memset is there to set at every position of the string a 0 to clear it
     memset(receive_bt, 0, sizeof(receive_bt));
-    memset(receive_gps, 0, sizeof(receive_gps));
     memset(receive_load_cell, 0, sizeof(receive_load_cell));
     memset(message_to_fly_controller, 0, sizeof(message_to_fly_controller));
     
@@ -194,308 +461,425 @@ void change_flugprozess_variable(void) {
     flight_process = false;
 }
 
-//To change the format from degrees minutes to degrees
-//The gps sends the positions in the degrees minutes format
-//so this has to be changed to degrees system
-double change_degree_minutes_to_degree(double tochange) {
-    double split = tochange;
-    double minutes;
-    int degrees = (int)split/100;
-    minutes = split - degrees*100;
-    double solution = (minutes/60) + degrees;
-    return solution;
-}
-
-//this function change a value in radians to a value in degrees
-//this is useful for the courseTO and distance function
-double radians_to_degrees(double rad) {     //Rad zu Grad
-    return (rad * 180.0) / M_PI;
+//this function parses the next number of the line in decimal degrees like
+//48.0739670 into 1e-7 degrees, the number ends at a space or at the end of
+//the line. Returns false when it is no number or outside of the limit
+static bool parse_degrees(const char** text, int32_t limit, int32_t* value) {
+    const char* start = *text;
+    nmea_field_t field;
+    
+    while(*start == ' ') {
+        start++;
+    }
+    field.text = start;
+    field.length = 0;
+    while(start[field.length] != '\0' && start[field.length] != ' '
+            && start[field.length] != '\r' && start[field.length] != '\n'
+            && field.length < UINT8_MAX) {
+        field.length++;
+    }
+    *text = start + field.length;
+    
+    return nmea_parse_fixed(&field, 7, value)
+            && *value <= limit && *value >= -limit;
 }
 
-//this function change a value in degrees to a value in radians
-//this is useful for the courseTO and distance function
-double degrees_to_radians(double degrees) { //Grad zu Rad
-    return ( degrees * M_PI) / 180;
+//this function calculates the signed error from the heading to the target in
+//1/100 degrees, both are in 1/100 degrees. The error is wrapped into
+//-18000 to 17999 so it always points the shortest way, positive is right
+int32_t heading_error(uint16_t target, uint16_t heading) {
+    int32_t error = ((int32_t)target - (int32_t)heading) % 36000;
+    
+    if(error >= 18000) {
+        error -= 36000;
+    } else if(error < -18000) {
+        error += 36000;
+    }
+    return error;
 }
 
-//this function calculates the distance between the start position and the end
-//position in meters.
-double distance(double start_lat, double start_lon, double end_lat, double end_lon) {
-    double latitude_mean = (start_lat + end_lat) / 2 * one_degree_in_radians; //returns a radiant value and not degree
-    double dx = latitude_distance * cos(latitude_mean) * (start_lon - end_lon); //changing value of longitude
-    double dy = latitude_distance * (start_lat - end_lat);      //changing value of latitude
-    double distance = (sqrt(dx * dx + dy * dy)) * 1000;     //distance in meter and no negativ distance
+//this function calculates the yaw command for the heading error in 1/100
+//degrees, it is proportional to the error and limited to the yaw range
+int32_t yaw_command(int32_t error) {
+    int32_t yaw = yaw_middle_value
+            + error * (yaw_max_value - yaw_middle_value) / yaw_full_error;
     
-    return distance;    //return the double distance 
+    if(yaw > yaw_max_value) {
+        yaw = yaw_max_value;
+    } else if(yaw < yaw_min_value) {
+        yaw = yaw_min_value;
+    }
+    return yaw;
 }
 
-//this function calculates the angle for the cardinal direction in which
-//cardinal direction the drone has to fly from the start position to the
-//end position. The unit is in degrees
-double courseTO(double lat1, double lon1, double lat2, double lon2) {   //calculate the compass direction
-    double dlon = degrees_to_radians(lon2-lon1);   //Calc the differenz longitude in radians
-    lat1 = degrees_to_radians(lat1);               //Latitudes in radians calculation
-    lat2 = degrees_to_radians(lat2);
-    double tangency = sin(dlon) * cos(lat2);  //get the tangency 
-    double partial = sin(lat1) * cos(lat2) * cos(dlon);  //calculate the partial value to 
-    partial = cos(lat1) * sin(lat2) - partial;
-    double direction_radiant = atan2(tangency, partial);    //calculat direction in radians
-    if(direction_radiant < 0.0) {
-        direction_radiant += TWO_PI;
-    }
-    return radians_to_degrees(direction_radiant);     //returns in which direction the drone has to fly
+//this function takes the sample of the selected heading source from the
+//events, a new fix for the course over ground or a new group of satellite
+//sentences for the azimuths. Returns false when there is no new sample
+static bool sample_heading(uint8_t events) {
+    if(heading_get_source() == HEADING_SOURCE_COURSE) {
+        if(!(events & event_fix)) {
+            return false;
+        }
+        heading_update_course(gps_get_fix());
+        return true;
+    }
+    
+    if(!(events & event_satellites)) {
+        return false;
+    }
+    
+    //when the gps modul has satellites in view
+    //then calculate the direction (azimuth) of the gps
+    const gps_satellite_table_t* satelites = gps_get_satellites();
+    if(satelites->count > 0) {
+        int32_t direction = compass_direction(satelites);
+        if(direction >= 0) {
+            heading_update_satellites((uint16_t)direction);
+        }
+    }
+    return true;
 }
 
-//this is a datatype of 4 variables with the name
-//single_satelite_data
-//this is to safe for each connected satellite their data
-//typedef struct {
-   // int amount;
-   // int elevation;
-   // int azimuth;
-   // int signal_strength;
-//}single_satelite_data;
-
-//this function calculates the strenght of the signal of the gps modul
-//to the satellites in dB. This is necessary because to calculate the
-//cardinal direction, it would be better to use the data from the satellites
-//with the strongest connection
-int split_satelites_data(char* data, single_satelite_data* satelites) {
-    int amountSatelites = 0;
-    char* key;
-    char* saveing;
-    
-    key = strtok_r(data,",", &saveing);
-    if((strcmp(key, satelite_prefix) != 0) || key == NULL)
-        return 0;
-    
-    key = strtok_r(NULL, ",", &saveing);
-    if(key == NULL)
-        return 0;
-    
-    amountSatelites = atoi(key);
-    if(amountSatelites > 12)
-        amountSatelites = 12;
-    
-    for(int i = 0; i < amountSatelites; i++) {
-        key = strtok_r(NULL, ",", &saveing);
-        if(key == NULL)
-            return 0;
-        
-        satelites[i].amount = atoi(key);
-        key = strtok_r(NULL, ",", &saveing);
-        if(key == NULL)
-            return 0;
-        
-        satelites[i].elevation = atoi(key);
-        key = strtok_r(NULL, ",", &saveing);
-        if(key == NULL)
-            return 0;
-        
-        satelites[i].azimuth = atoi(key);
-        key = strtok_r(NULL, ",", &saveing);
-        if(key == NULL)
-            return 0;
-        
-        satelites[i].signal_strength = atoi(key);
+//this function puts a message for the bluetooth modul into the queue, the
+//bluetooth task sends it when the uart is free. Returns false when the
+//queue is full and the message is lost
+bool bluetooth_send(const char* text) {
+    if((uint8_t)(bluetooth_write_index - bluetooth_read_index)
+            >= bluetooth_queue_count) {
+        bluetooth_lost++;
+        return false;
     }
-    return amountSatelites;
+    
+    uint8_t* message = bluetooth_queue[bluetooth_write_index
+            % bluetooth_queue_count];
+    strncpy((char*)message, text, bluetooth_queue_length - 1);
+    message[bluetooth_queue_length - 1] = '\0';
+    bluetooth_write_index++;
+    return true;
 }
 
-//this function calculates the cardinal direction of the drone
-//it will return a double in the unit degrees
-double compass_direction(single_satelite_data* satelites, int amountSatelites) {
-    double full_aszi = 0;
-    double full_signal = 0;
-    int used_satelites = 0;
-    for(int i = 0; i < amountSatelites; i++) {
-        if(satelites[i].signal_strength >= 10) {
-            full_aszi += satelites[i].azimuth * pow(10, 
-                    satelites[i].signal_strength / 10.0);
-            full_signal += pow(10, satelites[i].signal_strength / 10.0);
-            used_satelites++;
-        }
+//this function selects the source of the heading with the bluetooth
+//message "$HEADING,COG" or "$HEADING,SAT" and tells the user the source
+void select_heading_source(const char* message) {
+    size_t length = strlen(heading_prefix);
+    
+    if(strncmp(message + length, ",COG", 4) == 0) {
+        heading_set_source(HEADING_SOURCE_COURSE);
+    } else if(strncmp(message + length, ",SAT", 4) == 0) {
+        heading_set_source(HEADING_SOURCE_SATELLITES);
     }
     
-    if(used_satelites == 0)
-        return -1;
+    sprintf((char*)message_heading, "Richtung aus %s",
+            (heading_get_source() == HEADING_SOURCE_COURSE)
+            ? "Kurs ueber Grund" : "Satelliten");
+    bluetooth_send((const char*)message_heading);
+}
+
+//this function moves the position of the fix into the frame of the leg and
+//calculates the distance to the end position and the cross track error
+//the values will only be calculated again when there is a new fix
+//otherwise the values of the same fix will be kept
+static void update_leg_position(const gps_fix_t* fix) {
+    int32_t north, east;
     
-    double azimuth = full_aszi / full_signal;
-    azimuth = fmod(azimuth+360, 360); //change the azimuth range to 0 to 360
-    azimuth += magnetic_declination; //for the HTL add the magnetic declination
-    azimuth = fmod(azimuth+360, 360); //change the azimuth range to 0 to 360  
+    if(distance_sequence == fix->sequence) {
+        return;
+    }
     
-    return azimuth;
+    geo_leg_position(&flight_leg, fix->latitude, fix->longitude,
+            &north, &east);
+    current_distance = geo_leg_distance(&flight_leg, north, east);
+    geo_leg_track(&flight_leg, north, east, &current_along_track,
+            &current_cross_track);
+    distance_sequence = fix->sequence;
 }
 
-//this function is for the calculation of the current high of the drone and has
-//to be a double be more precise. The unit is in meters
-double read_current_altitude(void) {
-    //create a double variable for the return at read_current_altitude
-    double current_altitude;
-    
-    //$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
-    
-    //Read out the received data from gps as long as the message does not
-    //start with the gps prefix
-    while(memcmp(receive_gps, gps_prefix, strlen(gps_prefix)) != 0) {
-        //Set the receiving data value back to 0 to make it free
-        memset(receive_gps, 0, sizeof(receive_gps));
-        //read the uart received data
-        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
-    }
-    
-    //this dummy values are placeholders to be able to split the received
-    //string into its variables
-    char dummy_word1[20] = "";
-    char dummy_word2[5] = "";
-    char dummy_word3[5] = "";
-    double dummy_double1 = 0;
-    double dummy_double2 = 0;
-    double dummy_double3 = 0;
-    double dummy_double4 = 0;
-    int dummy_int1 = 0;
-    int dummy_int2 = 0;
-    
-    
-   //split the received string into its dummy variables and the current altitude
-    sscanf((const char*)receive_gps, "%s,%lf,%lf,%s,%lf,%s,%d,%d,%lf,%lf", 
-            dummy_word1, &dummy_double1,&dummy_double2, dummy_word2, 
-            &dummy_double3, dummy_word3, &dummy_int1, &dummy_int2, 
-            &dummy_double4, &current_altitude);
-    
-    //return the value of the double current_altitude
-    return current_altitude;
+//this function updates the altitude estimate with the fix, the vertical speed
+//is the change of the altitude between two fixes divided by the time
+//between them and smoothed over about 4 fixes
+void update_altitude(const gps_fix_t* fix) {
+    if(altitude_fix_ms == 0) {
+        current_vertical_speed = 0;
+    } else if(fix->timestamp != altitude_fix_ms) {
+        int32_t speed = (int32_t)(((int64_t)(fix->altitude - current_altitude)
+                * 1000) / (int32_t)(fix->timestamp - altitude_fix_ms));
+        current_vertical_speed += (speed - current_vertical_speed) / 4;
+    }
+    current_altitude = fix->altitude;
+    altitude_fix_ms = fix->timestamp;
 }
 
-//this function calculates the current distance of the drone to the end position
-//unit of this is in meters and has to be a double because to be more precise
-double read_current_distance(void) {
-    //create new variables for the calculation of the current_distance
-    double current_distance, current_latitude, current_longitude;
-    
-    //$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
-    
-    //Read out the received data from gps as long as the message does not
-    //start with the gps prefix
-    while(memcmp(receive_gps, gps_prefix, strlen(gps_prefix)) != 0) {
-        //Set the receiving data value back to 0 to make it free
-        memset(receive_gps, 0, sizeof(receive_gps));
-        //read the uart received data
-        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
-    }
-    
-    //this dummy values are placeholders to be able to split the received
-    //string into its variables
-    char dummy_word1[20] = "";
-    char dummy_word2[5] = "";
-    char dummy_word3[5] = "";
-    double dummy_double1 = 0;
-    
-    //split the received string into 
-    //its dummy variables and the current latitude and longitude
-    sscanf((const char*)receive_gps, "%s,%lf,%lf,%s,%lf,%s",
-            dummy_word1, &dummy_double1, &current_latitude, dummy_word2,
-            &current_longitude, dummy_word3);
-    
-    //change the value from "degrees, minute system" to "dezimaldegree system"
-    current_latitude = change_degree_minutes_to_degree(current_latitude);
-    current_longitude = change_degree_minutes_to_degree(current_longitude);
-    
-    //use the distance function from above to calculate the distance between
-    //the current position and the end positon
-    current_distance = distance(current_latitude, current_longitude,
-            end_lat, end_lon);
-    
-    //return the current distance to the end coordinates
-    return current_distance;
+//this function calculates the throttle to reach the target altitude in
+//millimetres. The altitude controller sets the vertical speed inside the
+//limits in millimetres per second and the vertical speed controller the
+//throttle around the middle value
+int32_t altitude_throttle(int32_t target, int32_t speed_min,
+        int32_t speed_max, uint32_t delta_ms) {
+    int32_t speed = pid_update(&control_parameter[control_altitude],
+            &control_state[control_altitude], target - current_altitude,
+            delta_ms);
+    
+    if(speed > speed_max) {
+        speed = speed_max;
+    } else if(speed < speed_min) {
+        speed = speed_min;
+    }
+    
+    return throttle_middle_value
+            + pid_update(&control_parameter[control_vertical_speed],
+            &control_state[control_vertical_speed],
+            speed - current_vertical_speed, delta_ms);
 }
 
-//this function will return the current latitude in degrees
-double read_current_latitude(void) {
-    //create a variable for the return
-    double current_latitude;
+//this function sends the time to the first fix and to 8 satellites after the
+//start over bluetooth, with the age of the hot start position in minutes
+//and if the almanac of the gps modul was complete at the last flight
+void send_gps_start_report(const gps_fix_t* fix) {
+    uint32_t first_fix_ms, good_satellites_ms, age_s;
+    const hotstart_record_t* record = hotstart_get_record();
     
-    //$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
-    
-    //Read out the received data from gps as long as the message does not
-    //start with the gps prefix
-    while(memcmp(receive_gps, gps_prefix, strlen(gps_prefix)) != 0) {
-        //Set the receiving data value back to 0 to make it free
-        memset(receive_gps, 0, sizeof(receive_gps));
-        //read the uart received data
-        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
-    }
+    gps_get_start_times(&first_fix_ms, &good_satellites_ms);
     
-    //this dummy values are placeholders to be able to split the received
-    //string into its variables
-    char dummy_word1[20] = "";
-    double dummy_double1 = 0;
+    int length = sprintf((char*)message_gps_start,
+            "TTFF %lu.%lu s 8 Sat %lu.%lu s",
+            (unsigned long)(first_fix_ms / 1000),
+            (unsigned long)(first_fix_ms % 1000 / 100),
+            (unsigned long)(good_satellites_ms / 1000),
+            (unsigned long)(good_satellites_ms % 1000 / 100));
     
-    //split the received string into 
-    //its dummy variables and the current latitude and longitude
-    sscanf((const char*)receive_gps, "%s,%lf,%lf",
-            dummy_word1, &dummy_double1, &current_latitude);
+    if(record == NULL) {
+        sprintf((char*)message_gps_start + length, " Kaltstart");
+    } else if(hotstart_get_age(fix, &age_s)) {
+        sprintf((char*)message_gps_start + length, " Hotstart %lu min %s",
+                (unsigned long)(age_s / 60),
+                record->tracking_s >= HOTSTART_ALMANAC_TRACKING_S ?
+                "Almanach" : "");
+    } else {
+        sprintf((char*)message_gps_start + length, " Hotstart");
+    }
     
-    //change the value from degrees, minute system to dezimaldegree system
-    current_latitude = change_degree_minutes_to_degree(current_latitude);
+    bluetooth_send((const char*)message_gps_start);
+}
+
+//function to create the message which will be send over uart at SERCOM1
+//to the flight controller with the values of the roll, pitch, yaw and
+//throttle. The values are decimal integers separated by spaces and the line
+//ends with a line feed, like "1500 1750 1500 1250\n"
+void write_flight_controller(int32_t roll, int32_t pitch, int32_t yaw,
+        int32_t throttle) {
     
-    //Return the value of the current latitude variable
-    return current_latitude;
+    //put the values into a string, it is sent by the output task
+    sprintf((char*)message_to_fly_controller, "%ld %ld %ld %ld\n",
+            (long)roll, (long)pitch, (long)yaw, (long)throttle);
+    command_pending = true;
 }
 
-//this function will return the current longitude in degrees
-double read_current_longitude(void) {
-    //create a variable for the return
-    double current_longitude;
+//this function is the output task to the flight controller. It sends a new
+//command at the rate of the task and repeats the last one when there was no
+//new command for the refresh time
+void flight_controller_task(void) {
+    if(message_to_fly_controller[0] == 0 || SERCOM1_USART_WriteIsBusy()) {
+        return;
+    }
+    if(!command_pending && !timer_expired(TIMER_COMMAND_REFRESH)) {
+        return;
+    }
     
-    //$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
+    //write the data of the message to over uart to the flight controller,
+    //only the characters of the command are sent
+    size_t length = strlen((const char*)message_to_fly_controller);
+    memcpy(transmit_fly_controller, message_to_fly_controller, length);
+    SERCOM1_USART_Write(transmit_fly_controller, length);
+    command_pending = false;
+    timer_start(TIMER_COMMAND_REFRESH, command_refresh_ms, false, NULL);
     
-    //Read out the received data from gps as long as the message does not
-    //start with the gps prefix
-    while(memcmp(receive_gps, gps_prefix, strlen(gps_prefix)) != 0) {
-        //Set the receiving data value back to 0 to make it free
-        memset(receive_gps, 0, sizeof(receive_gps));
-        //read the uart received data
-        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
+    //the age of the used gps sentence at the time of the message
+    const gps_fix_t* fix = gps_get_fix();
+    if(fix->sequence != 0) {
+        decision_latency_us = systime_get_us() - fix->receive_end_us;
+    }
+}
+
+//this function is the navigation task, it is released by the control tick
+//and runs the flight process while there is one
+void navigation_task(void) {
+    control_tick_start();
+    if(get_fly_process()) {
+        fly_process();
+    }
+}
+
+//this function writes the next line of the report into the buffer, one
+//line for every task, one line with the longest pass for every state of the
+//flight process, the ticks, misses and lateness histogram of the control
+//tick, the idle share with the estimated current, the cycles of the DIVAS
+//against libgcc and the software root, the cycles of the geodesy of one fix
+//and one leg against the old soft float functions with the factor of the
+//fix and the load of all tasks with the lost bluetooth messages at the end
+static void format_report_line(uint8_t index) {
+    if(index < SCHEDULER_TASK_COUNT) {
+        const scheduler_stats_t* stats = scheduler_get_stats(index);
+        uint16_t load = scheduler_get_task_load(index);
+        sprintf((char*)message_report,
+                "$TASK %s %lu us max %lu us %u.%02u %% over %lu miss %lu",
+                scheduler_tasks[index].name, (unsigned long)stats->last_us,
+                (unsigned long)stats->max_us, load / 100, load % 100,
+                (unsigned long)stats->overruns, (unsigned long)stats->missed);
+    } else if(index < report_tick_line) {
+        uint8_t state = index - SCHEDULER_TASK_COUNT;
+        sprintf((char*)message_report, "$STATE %s max %lu us",
+                flight_states[state].name,
+                (unsigned long)flight_state_max_us[state]);
+    } else if(index == report_tick_line) {
+        const control_tick_stats_t* tick = control_tick_get_stats();
+        sprintf((char*)message_report,
+                "$TICK %u Hz %lu miss %lu late max %lu us",
+                control_tick_get_rate(), (unsigned long)tick->ticks,
+                (unsigned long)tick->misses,
+                (unsigned long)tick->max_lateness_us);
+    } else if(index == report_tick_line + 1) {
+        //starts of the control step up to 50, 100, 200, 500, 1000, 2000,
+        //5000 us and later after the tick
+        const control_tick_stats_t* tick = control_tick_get_stats();
+        int length = sprintf((char*)message_report, "$JITTER");
+        for(uint8_t i = 0; i < CONTROL_TICK_BINS; i++) {
+            length += sprintf((char*)message_report + length, " %lu",
+                    (unsigned long)tick->histogram[i]);
+        }
+    } else if(index == report_power_line) {
+        uint16_t idle = power_get_idle();
+        sprintf((char*)message_report, "$POWER idle %u.%02u %% %lu uA",
+                idle / 100, idle % 100,
+                (unsigned long)power_get_current_ua());
+    } else if(index == report_divas_line) {
+        const divas_benchmark_t* benchmark = divas_get_benchmark();
+        sprintf((char*)message_report,
+                "$DIVAS div %u libgcc %u sqrt %u bits %u cycles",
+                benchmark->divas_cycles, benchmark->libgcc_cycles,
+                benchmark->sqrt_cycles, benchmark->bits_cycles);
+    } else if(index == report_geo_line) {
+        const geo_benchmark_t* benchmark = geo_get_benchmark();
+        uint32_t factor = 0;
+        if(benchmark->fix_cycles > 0) {
+            factor = benchmark->old_cycles * 10 / benchmark->fix_cycles;
+        }
+        sprintf((char*)message_report,
+                "$GEO fix %lu leg %lu old %lu cycles x%lu.%lu",
+                (unsigned long)benchmark->fix_cycles,
+                (unsigned long)benchmark->leg_cycles,
+                (unsigned long)benchmark->old_cycles,
+                (unsigned long)(factor / 10), (unsigned long)(factor % 10));
+    } else {
+        uint16_t load = scheduler_get_load();
+        sprintf((char*)message_report, "$LOAD %u.%02u %% lost %lu",
+                load / 100, load % 100, (unsigned long)bluetooth_lost);
+    }
+}
+
+//this function is the bluetooth task. The report of the tasks and the
+//source of the heading are handled here at every time, all other lines are
+//given to the flight process. When the uart is free the next message of the
+//queue is sent, without one the lines of a report one after the other
+void bluetooth_task(void) {
+    if(!SERCOM2_USART_WriteIsBusy()) {
+        if(bluetooth_read_index != bluetooth_write_index) {
+            strcpy((char*)bluetooth_transmit, (const char*)bluetooth_queue[
+                    bluetooth_read_index % bluetooth_queue_count]);
+            bluetooth_read_index++;
+            SERCOM2_USART_Write(bluetooth_transmit,
+                    strlen((const char*)bluetooth_transmit));
+        } else if(report_index < report_lines) {
+            format_report_line(report_index);
+            SERCOM2_USART_Write(message_report,
+                    strlen((const char*)message_report));
+            report_index++;
+        }
     }
     
-    //this dummy values are placeholders to be able to split the received
-    //string into its variables
-    char dummy_word1[20] = "";
-    char dummy_word2[5] = "";
-    double dummy_double1 = 0;
-    double dummy_double2 = 0;
+    //a line which the flight process has not used yet is not overwritten
+    if(bluetooth_line_ready) {
+        return;
+    }
+    if(!uart_line_read(UART_LINE_BLUETOOTH, receive_bt, sizeof(receive_bt),
+            NULL)) {
+        return;
+    }
     
-    //split the received string into 
-    //its dummy variables and the current latitude and longitude
-    sscanf((const char*)receive_gps, "%s,%lf,%lf,%s,%lf",
-            dummy_word1, &dummy_double1, &dummy_double2, dummy_word2,
-            &current_longitude);
+    if(strncmp((const char*)receive_bt, stats_prefix,
+            strlen(stats_prefix)) == 0) {
+        report_index = 0;
+        memset(receive_bt, 0, sizeof(receive_bt));
+    } else if(strncmp((const char*)receive_bt, heading_prefix,
+            strlen(heading_prefix)) == 0) {
+        select_heading_source((const char*)receive_bt);
+        memset(receive_bt, 0, sizeof(receive_bt));
+    } else {
+        bluetooth_line_ready = true;
+    }
+}
+
+//this function is the load cell task, it starts a read of the load cell
+//and takes the weight into the payload at the next run when the transfer
+//is finished. When the payload is not needed the clocks of the load cell
+//are switched off after the last transfer
+void load_cell_task(void) {
+    if(load_cell_busy) {
+        if(SERCOM0_I2C_IsBusy()) {
+            return;
+        }
+        load_cell_busy = false;
+        
+        //the load cell sends the weight in kilograms as text, it is taken
+        //in grams
+        nmea_field_t field = {(const char*)receive_load_cell, 0};
+        while(field.length < UINT8_MAX
+                && receive_load_cell[field.length] != '\0'
+                && receive_load_cell[field.length] != '\r'
+                && receive_load_cell[field.length] != '\n') {
+            field.length++;
+        }
+        int32_t weight;
+        if(nmea_parse_fixed(&field, 3, &weight)) {
+            payload = weight;
+        }
+        return;
+    }
     
-    //change the value from degrees, minute system to dezimaldegree system
-    current_longitude = change_degree_minutes_to_degree(current_longitude);
+    power_set_load_cell(load_cell_needed);
+    if(!load_cell_needed) {
+        return;
+    }
     
-    //return the value of the current_longitude variable
-    return current_longitude;
+    //read the uart message from sercom0 to get the load cell weight
+    if(SERCOM0_I2C_Read(711, receive_load_cell, sizeof(receive_load_cell))) {
+        load_cell_busy = true;
+    }
 }
 
-//function to create the message which will be send over uart at SERCOM1
-//to the flight controller with the values of the roll, pitch, yaw and throttle
-void write_flight_controller(double roll, double pitch, double yaw, 
-        double throttle) {
-    
-    //put the double variables into a string
-    sprintf((char*)message_to_fly_controller, "%lf %lf %lf %lf", roll, pitch, yaw, throttle);
+//this function is the logging task, during the flight it sends the state
+//of the flight process, the distance and the cross track error in cm, the
+//altitude in mm and the load of all tasks to the bluetooth modul
+void logging_task(void) {
+    if(!setup_complete || report_index < report_lines
+            || bluetooth_read_index != bluetooth_write_index
+            || SERCOM2_USART_WriteIsBusy()) {
+        return;
+    }
     
-    //write the data of the message to over uart to the flight controller
-    SERCOM1_USART_Write(message_to_fly_controller, 
-            sizeof(message_to_fly_controller));
+    uint16_t load = scheduler_get_load();
+    sprintf((char*)message_log, "$LOG %s %lu %ld %ld %u.%02u",
+            flight_states[flight_state].name, (unsigned long)current_distance,
+            (long)current_cross_track, (long)current_altitude,
+            load / 100, load % 100);
+    SERCOM2_USART_Write(message_log, strlen((const char*)message_log));
 }
 
 //this function is for the end process and will be called when the flight
 //process is ready for the reset
 void end_of_flight_process(void) {
+    //save the landing position for the hot start of the next flight
+    hotstart_save(gps_get_fix());
+    
     //Set all necessary variables for the flight process to 0
     change_flugprozess_variable();
 }
@@ -518,643 +902,640 @@ void set_fly_process(bool set) {
 /* ************************************************************************** */
 /* ************************************************************************** */
 
-//this function controlls the full fly protocol and the setup
-void fly_process(void) {
-    switch(process_state) { //proces for the full fly process
-        case(0): {      //setup process
-            if(setup_complete) {    //if the setup is complete
-                process_state = 1;  //switch to the next state
-            } else {
-            
-            switch(setup_state) {   //For the Setup all Steps
-                
-                case(0): {          //Case for Bluetooth Coords receiving
-                    
-                    controll_LED_Set();
-                    
-                    //While there is no receiving data from sercom2
-                    while(memcmp(receive_bt, empty_string, 250) == 0) {
-                        //read the uart received data from sercom2 
-                        SERCOM2_USART_Read(receive_bt, sizeof(receive_bt));
-                    }
-                    //delay of 500ms to be sure data could be finished reading
-                    delay_ms(500);
-                    
-                    //Coords will look like: $COORDS 000.00000 000.00000
-                    //check if the message starts with the coords prefix
-                    if(memcmp(receive_bt, coords_prefix
-                            , strlen(coords_prefix)) == 0) {
-                        //create a variable for the coods prefix COORDS
-                        char dummy_data[100];
-                        //split up the coords into doubles and a dummy part
-                        sscanf((const char*)receive_bt, "%s %lf %lf", 
-                                dummy_data, &end_lat, &end_lon);
-                        //delay of 50ms 
-                        delay_ms(50);
-                        //reset dummy value
-                        memset(dummy_data, 0, sizeof(dummy_data));
-                        //step to the next setup process
-                        setup_state = 1;
-                    }
-                    //Reset String if it was false or finish with reading
-                    memset(receive_bt, 0, sizeof(receive_bt));
-                    //end this case
-                    break;
-                }
-                
-                case(1): {     //Case for getting first time the start position
-                    //while receiving message from gps is empty
-                    while(memcmp(receive_gps, empty_string, 250) == 0) {
-                        //read the uart received data
-                        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
-                    }
-                    //while the message has not the gps prefix
-                    while(memcmp(receive_gps, gps_prefix, strlen(gps_prefix))
-                            != 0) {
-                        //Set the receiving data value back to 0 to make it free
-                        memset(receive_gps, 0, sizeof(receive_gps));
-                        //read the uart received data
-                        SERCOM3_USART_Read(receive_gps, sizeof(receive_gps));
-                    }
-                    //delay of 500ms to be sure that all data could be finished
-                    delay_ms(500);
-                    
-//$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
-                    //placeholder just for upper example the prefix GNGGA
-                    char dummy_data[100];
-                    //placeholder just for upper example N
-                    char dummy_word1[10];
-                    //placeholder just for upper example E
-                    char dummy_word2[10];
-                    //placeholder just for upper example 100855.00
-                    float dummy_time;
-                    //placeholder just for upper example 0.96
-                    float dummy_float1;
-                    //placeholder just for upper example 1 
-                    int dummy_int1;
-                    //split all variables with a form schematic
-                    sscanf((const char*)receive_gps, 
-                            "%s,%f,%lf,%s,%lf,%s,%d,%d,%f,%lf", dummy_data, 
-                            &dummy_time, &start_lat, dummy_word1, &start_lon,
-                            dummy_word2, &dummy_int1, &satelites_connected,
-                            &dummy_float1, &altitude_start_position);
-                    //delay of 50 ms to be sure everything could be done
-                    delay_ms(50);
-                    
-                    //change start latitude to the degrees system
-                    start_lat = change_degree_minutes_to_degree(start_lat);
-                    //change start longitude to the degrees system
-                    start_lon = change_degree_minutes_to_degree(start_lon);
-                    
-                    //set the value back to 0 to clear it
-                    memset(receive_gps, 0, sizeof(receive_gps));
-                    
-                    //when more than 8 satelites are connected then the program
-                    //can move to the next state
-                    //This safety query is required
-                    //because the gps module is not exactly when there less
-                    //than 8 satelites are connected
-                    if(satelites_connected >= 8) {
-                        //step to the next state
-                        setup_state = 2;
-                    }
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(2): { //Case for calculating the distance and the direction
-                    
-                    //Calculate the direction with nord is 0 and west is 270
-                    himmelsrichtung = courseTO(start_lat, start_lon,
-                            end_lat, end_lon);
-                    
-                    //Calculate the distance between this two coords
-                    entfernung = distance(start_lat, start_lon,
-                            end_lat, end_lon);
-                    
-                    //step to the next process
-                    setup_state = 3;
-                    //end this case
-                    break;
-                }
-                
-                case(3): {  //Case to check the weight is not more than the max
-                    //while the payload is null or to heavy 
-                    while(payload == 0 || payload > max_weight) {
-                        
-                        //read the uart message from sercom0 to get the
-                        //load cell weight
-                        SERCOM0_I2C_Read(711, receive_load_cell, 
-                                sizeof(receive_load_cell));
-                        
-                        //transfer the value of the load cell from the 
-                        //receive_load_cell string to the double variable
-                        sscanf((const char*)receive_load_cell, "%lf", &payload);
-                        
-                        //delay of 50ms to be sure that the variable has been
-                        //overwritten correctly
-                        delay_ms(50);
-                        
-                        //if the load cell weight is higher than the max weight
-                        if(payload > max_weight) {
-                            
-                            //write over uart to the bluetooth modul, that the
-                            //weight is to heavy
-                            SERCOM2_USART_Write(message_overweight,
-                                    sizeof(message_overweight));   
-                            delay_ms(3000); //delay of 3 seconds
-                        } else {
-                            setup_state = 4;    //step to the next process
-                            
-                            //write over uart to the bluetooth modul, that the
-                            //drone is ready for the flight
-                            SERCOM2_USART_Write(message_ready_to_start,
-                                    sizeof(message_ready_to_start));
-                            delay_ms(50);   //delay of 50ms
-                        }
-                    }
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(4): {  //case to calculate the direction of the compass
-                    
-                    single_satelite_data satelites[12];
-                    int amoutSatelites = 0;
-                    char buffer[128];
-                    
-                    for(int i = 0; i< 12; i++) {
-                        while(memcmp(receive_gps, satelite_prefix, 
-                                strlen(satelite_prefix)) != 0) {
-                            SERCOM3_USART_Read(receive_gps, 
-                                    sizeof(receive_gps));
-                        }
-                        
-                        amoutSatelites = split_satelites_data(buffer, satelites);
-                        if(amoutSatelites > 0) {
-                            azimuth = compass_direction(satelites, 
-                                    amoutSatelites);
-                        }
-                    }
-                    
-                    if(amoutSatelites > 0) {    //when there are connected sats
-                        setup_state = 5;    //move to the next setup state
-                    }
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(5): {  //case to wait for the start signal from the user
-                    //while the received data from bluetooth over uart
-                    //is empty, the microcontroller will continue 
-                    //reading the data
-                    while(memcmp(receive_bt, empty_string,
-                            250) == 0) {
-                        SERCOM2_USART_Read(receive_bt, sizeof(receive_bt));
-                    }
-                    
-                    //when the received data contains the start signal
-                    //in the message, then the microcontroller
-                    //will tell the user that the flightprocess begins
-                    if(memcmp(receive_bt, start_signal, sizeof(start_signal)) 
-                            == 0) {
-                        SERCOM2_USART_Write(message_fly_starts,
-                                sizeof(message_fly_starts));
-                        delay_ms(50);   //delay of 50ms
-                    }
-                    
-                    //set the boolean setup complete true because the setup
-                    //has been finished and the program can move on to the
-                    //next flight process
-                    setup_complete = true;
-                        
-                    //Reset String if it was false or finish with reading
-                    memset(receive_bt, 0, sizeof(receive_bt));
-                    
-                    //turn off the LED of the battery state
-                    controll_LED_Clear();
-                    
-                    //end this case
-                    break;
-                }
-            }
-            }
-            //end this case
-            break;
-        }
-        
-        case(1): {  //Takeoff case
-            
-            //switch case function for the takeoff process to controll 
-            //single steps which are necessary for the takeoff
-            switch(takeoff_process) {
-                case(0): {  //case to fly up on the maximum high
-                    
-                    //while the current high of the drone is lower than
-                    //the max flight high the drone flies up
-                    while(read_current_altitude() <= 
-                            (altitude_start_position + delta_limited_high)) {
-                        
-                        //write function for the flight controller
-                        //to let the drone fly higher with a middle gas
-                        write_flight_controller(roll_value, pitch_middle_value, 
-                                yaw_middle_value, throttle_max_value);
-                    }
-                    //write function for the flight controller
-                    //to hold the current positon in the air
-                    write_flight_controller(roll_value,pitch_middle_value,
-                            yaw_middle_value, throttle_middle_value);
-                    
-                    //move to the next step of the takeoff process
-                    takeoff_process = 1;
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(1): {  //case to rotate the drone in the right direction
-                    
-                    //while the cardinal direction is not in the direction
-                    //where the end position is
-                    while(azimuth <= (himmelsrichtung - compass_tolerance) || 
-                            azimuth >= (himmelsrichtung + compass_tolerance)) {
-                        
-                        //to allow the access to the structure
-                        single_satelite_data satelites[12];
-                        
-                        //this variable defines the amount of satellites 
-                        //which are connected with the the gps modul
-                        int amoutSatelites = 0;
-                        char buffer[128];
-                        
-                        //this for function will run the internal code 12 times
-                        for(int i = 0; i< 12; i++) {
-                            //read the received gps data from uart as long as
-                            //the right gps data are not there
-                            while(memcmp(receive_gps, satelite_prefix, 
-                                strlen(satelite_prefix)) != 0) {
-                                //read the received uart data from SERCOM3 GPS
-                                SERCOM3_USART_Read(receive_gps, 
-                                        sizeof(receive_gps));
-                            }
-                            
-                            //to get the satellites with the best connection
-                            //to the gps modul
-                            amoutSatelites = split_satelites_data(buffer, 
-                                    satelites);
-                            
-                            //when the gps modul has connected satellites
-                            //then calculate the direction (azimuth) of the gps
-                            if(amoutSatelites > 0) {
-                                azimuth = compass_direction(satelites, 
-                                        amoutSatelites);
-                            }
-                        }
-                        
-                        //write function for the flight controller 
-                        //to rotate right around in the air
-                        write_flight_controller(roll_value, pitch_middle_value, 
-                                1600, throttle_middle_value);
-                    }
-                    
-                    //write function for the flight controller
-                    //to hold the current positon in the air
-                    write_flight_controller(roll_value, pitch_middle_value, 
-                            yaw_middle_value, throttle_middle_value);
-                    
-                    //when the cardinal direction is in the tolerance range
-                    if(azimuth > (himmelsrichtung - compass_tolerance) || 
-                            azimuth < (himmelsrichtung + compass_tolerance)) {
-                        //move on to the next step of the full fligth process
-                        process_state = 2;
-                    }
-                    //end this case
-                    break;
-                }
-            }
-            //end this case
-            break;
-        }
-        
-        case(2): {  //fly to the endposition case
-            
-            //while the distance to the end position is bigger than 10meters the
-            //drone can fly faster to the position to save energy
-            while(read_current_distance() > 10.0) {
-                write_flight_controller(roll_value, 1700, yaw_middle_value,
-                        1700);
-            }
-            
-            //while the distance is less than 10.0 meters and higher or equal 2
-            //meters, the drone should fly slower to the end position
-            while(read_current_distance() <= 10.0 
-                    && read_current_distance() >= 2.0) {
-                write_flight_controller(roll_value, 1600, yaw_middle_value,
-                        1600);
-            }
-            
-            //while the distance is less than 2.0 meters and higher or equal 0.2
-            //meters, the drone should fly slower to the end position
-            //to land more precise at the exat end position
-            while(read_current_distance() >= 0.2 
-                    && read_current_distance() <= 2.0) {
-                write_flight_controller(roll_value, 1550, yaw_middle_value,
-                        1550);
-            }
-            
-            //when the drone is in a distance of the tolerance range of 0.2
-            //than stop in the air hold the position and move on to the 
-            //next flight process
-            if(read_current_distance() < 0.2) {
-                write_flight_controller(roll_value, 1500, yaw_middle_value,
-                        1500);
-                
-                //move to the next step of the flight process
-                process_state = 3;
-            }
-            
-            //end this case
-            break;
-        }
-        
-        case(3): {  //case for the landing process
-            
-            //while the drone is landing and its high is higher than
-            //1 meter the drone can land faster than when the high is less than
-            //1 meter
-            while(read_current_altitude() > (altitude_start_position + 1)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, 1300);
-            }
-            
-            //while the drone is landing and its high is less than 1 meter
-            //the speed of landing has to be slower
-            while(read_current_altitude() <= (altitude_start_position + 1)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, 1400);
-            }
-            
-            //when the drone is 5cm or less away from the ground the drone
-            //set the throttle variable to the minimum start speed
-            if(read_current_altitude() < (altitude_start_position + 0.05)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, throttle_min_value);
-                
-                //Wait 2 minutes to take the package out of the box
-                delay_ms(60000);
-                delay_ms(60000);
-                //move to the next flight process step
-                process_state = 4;
-            }
-            
-            //end this case
-            break;
+//this function starts a climb or a descent with the altitude controller to
+//the target altitude in millimetres, if it climbs or descends is known with
+//the first fix of the phase
+static void altitude_phase_enter(int32_t target, bool landing) {
+    altitude_target = target;
+    altitude_landing = landing;
+    altitude_climbing = !landing;
+    altitude_start_ms = systime_get_ms();
+    altitude_last_fix_ms = 0;
+    
+    pid_reset(&control_state[control_altitude]);
+    pid_reset(&control_state[control_vertical_speed]);
+    altitude_fix_ms = 0;
+    altitude_overshoot = 0;
+}
+
+//this function runs the altitude controller once for every new fix. A climb
+//ends when the drone has settled inside the altitude tolerance, a landing
+//ends at the landing high above the target. Returns true at the end
+static bool altitude_phase_step(uint8_t events) {
+    if(!(events & event_fix)) {
+        return false;
+    }
+    const gps_fix_t* fix = gps_get_fix();
+    if(altitude_last_fix_ms == 0) {
+        altitude_climbing = altitude_target > fix->altitude;
+    }
+    update_altitude(fix);
+    
+    //the overshoot is the altitude beyond the target in the direction of
+    //the climb or descent
+    int32_t error = altitude_target - current_altitude;
+    if(altitude_climbing && error < 0
+            && (uint32_t)-error > altitude_overshoot) {
+        altitude_overshoot = (uint32_t)-error;
+    } else if(!altitude_climbing && error > 0
+            && (uint32_t)error > altitude_overshoot) {
+        altitude_overshoot = (uint32_t)error;
+    }
+    
+    if(altitude_landing) {
+        if(current_altitude < altitude_target + landing_high) {
+            return true;
         }
-        
-        //in this case all necessary variables to fly back will be swapped
-        case(4): {  //setup process for the return flight
-            
-            //switch case function for the backflight setup
-            switch(backflight_setup_state) {
-                case(0): {  //case for swapping the position variables
-                    //to safe the value of the start position between two steps
-                    double step_lat, step_lon;
-
-                    //safe the start position in a cache to use them later as the 
-                    //coords for the back flight
-                    step_lat = start_lat;
-                    step_lon = start_lon;
-
-                    //set the current position as the start coords
-                    start_lat = read_current_latitude();
-                    start_lon = read_current_longitude();
-
-                    //set the safed values from the cache in for the end position
-                    //because the drone has to fly back
-                    end_lat = step_lat;
-                    end_lon = step_lon;
-                    
-                    //change the start_altitude value to the altitude 
-                    //of the new position
-                    altitude_start_position = read_current_altitude();
-                    
-                    //change the distance variable entfernung
-                    entfernung = distance(start_lat, start_lon,
-                            end_lat, end_lon);
-                    
-                    //change the direction in which the drone has to fly
-                    himmelsrichtung = courseTO(start_lat, start_lon,
-                            end_lat, end_lon);
-                    
-                    //move on to the next step
-                    backflight_setup_state = 1;
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(1): {  //check if the payload is okay
-                    
-                   //while the payload is null or to heavy 
-                    while(payload == 0 || payload > max_weight) {
-                        
-                        //read the uart message from sercom0 to get the
-                        //load cell weight
-                        SERCOM0_I2C_Read(711, receive_load_cell, 
-                                sizeof(receive_load_cell));
-                        
-                        //transfer the value of the load cell from the 
-                        //receive_load_cell string to the double variable
-                        sscanf((const char*)receive_load_cell, "%lf", &payload);
-                    }
-                    
-                        //delay of 50ms to be sure that the variable has been
-                        //overwritten correctly
-                        delay_ms(50);
-                        
-                        //if the load cell weight is less than the max weight
-                        if(payload < max_weight) {
-                            process_state = 5;
-                        }
-                    //end this case
-                    break;
-                }
-            }
-            
-            //end this case
-            break;
+    } else if(error >= -altitude_tolerance && error <= altitude_tolerance
+            && current_vertical_speed >= -altitude_settle_speed
+            && current_vertical_speed <= altitude_settle_speed) {
+        return true;
+    }
+    
+    //time between the fixes, it is 0 for the first fix of the phase
+    uint32_t delta_ms = (altitude_last_fix_ms == 0) ? 0
+            : fix->timestamp - altitude_last_fix_ms;
+    altitude_last_fix_ms = fix->timestamp;
+    
+    //near the ground the drone lands slower
+    int32_t speed_min = -descent_speed;
+    if(altitude_landing
+            && current_altitude < altitude_target + slow_descent_high) {
+        speed_min = -slow_descent_speed;
+    }
+    
+    write_flight_controller(roll_value, pitch_middle_value, yaw_middle_value,
+            altitude_throttle(altitude_target, speed_min, climb_speed,
+            delta_ms));
+    return false;
+}
+
+//this function ends a climb or a descent, the time and the overshoot are
+//sent to the bluetooth modul
+static void altitude_phase_exit(void) {
+    altitude_phase_ms = systime_get_ms() - altitude_start_ms;
+    if(!altitude_landing) {
+        hold_altitude = altitude_target;
+    }
+    
+    //tell the user how long the climb or descent took and how far it
+    //overshot the target altitude
+    sprintf((char*)message_altitude, "%s %lu ms Ueberschwingen %lu mm",
+            altitude_climbing ? "Steigen" : "Sinken",
+            (unsigned long)altitude_phase_ms,
+            (unsigned long)altitude_overshoot);
+    bluetooth_send((const char*)message_altitude);
+}
+
+//this function moves the fix into the frame of the leg and corrects the
+//predictor and the altitude estimate with it, the time of the fix is the
+//end of its sentence
+static void correct_leg_position(const gps_fix_t* fix) {
+    int32_t position[PREDICTOR_AXES];
+    
+    geo_leg_position(&flight_leg, fix->latitude, fix->longitude,
+            &position[PREDICTOR_NORTH], &position[PREDICTOR_EAST]);
+    predictor_correct(&leg_predictor, position, fix->hdop,
+            fix->receive_end_us);
+    update_altitude(fix);
+}
+
+//state for the coordinates of the end position from the bluetooth modul
+static void coordinates_enter(void) {
+    controll_LED_Set();
+}
+
+static uint8_t coordinates_step(uint8_t events) {
+    //Coords will look like: $COORDS 000.00000 000.00000
+    //check if the message starts with the coords prefix
+    if(!(events & event_bluetooth)
+            || memcmp(receive_bt, coords_prefix, strlen(coords_prefix)) != 0) {
+        return state_coordinates;
+    }
+    
+    //the latitude and the longitude in degrees are taken in 1e-7 degrees,
+    //a line with broken coordinates is ignored
+    const char* text = (const char*)receive_bt + strlen(coords_prefix);
+    int32_t latitude, longitude;
+    if(!parse_degrees(&text, 900000000L, &latitude)
+            || !parse_degrees(&text, 1800000000L, &longitude)) {
+        return state_coordinates;
+    }
+    end_latitude = latitude;
+    end_longitude = longitude;
+    return state_start_position;
+}
+
+//state for getting first time the start position, it goes on with a fix
+//of 8 or more satellites
+//$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
+static uint8_t start_position_step(uint8_t events) {
+    if(!(events & event_fix)) {
+        return state_start_position;
+    }
+    
+    //the position of the fix is in 1e-7 degrees and the altitude in
+    //millimetres
+    const gps_fix_t* fix = gps_get_fix();
+    start_latitude = fix->latitude;
+    start_longitude = fix->longitude;
+    start_altitude = fix->altitude;
+    satelites_connected = fix->satellites;
+    
+    //This safety query is required because the gps module is not exactly
+    //when there less than 8 satelites are connected
+    if(satelites_connected < 8) {
+        return state_start_position;
+    }
+    
+    //save the position for the hot start of the next flight and tell the
+    //user how long the gps modul needed for the first fix and for 8
+    //satellites
+    hotstart_save(fix);
+    send_gps_start_report(fix);
+    return state_payload;
+}
+
+//state to check the weight is not more than the max, at the start the
+//distance and the direction of the leg are calculated
+static void payload_enter(void) {
+    load_cell_needed = true;
+    
+    //build the north east frame of the leg once, every fix of the flight
+    //is then moved into this frame
+    geo_leg_initialize(&flight_leg, start_latitude, start_longitude,
+            end_latitude, end_longitude);
+    distance_sequence = 0;
+    
+    //tell the user the baud rate and the update rate of the gps modul and if
+    //the time is synchronised with the PPS, the rate is measured in 1/100 Hz
+    uint16_t fix_rate = gps_get_fix_rate();
+    sprintf((char*)message_gps_status, "GPS %lu Baud %u.%02u Hz PPS %s",
+            (unsigned long)gps_get_baud_rate(), fix_rate / 100,
+            fix_rate % 100, systime_is_synchronised() ? "ok" : "-");
+    bluetooth_send((const char*)message_gps_status);
+}
+
+static uint8_t payload_step(uint8_t events) {
+    //the payload comes from the load cell task, when the weight is too
+    //heavy the message is repeated after the wait of the last one
+    if(payload > max_weight) {
+        if(!timer_is_running(TIMER_OVERWEIGHT)) {
+            bluetooth_send((const char*)message_overweight);
+            timer_start(TIMER_OVERWEIGHT, overweight_wait_ms, false, NULL);
         }
-        
-        case(5): {  //takeoff process for the backflight
-            
-            //switch case function for the takeoff process to controll 
-            //single steps which are necessary for the takeoff
-            switch(backflight_takeoff_process) {
-                case(0): {  //case to fly up on the maximum high
-                    
-                    //while the current high of the drone is lower than
-                    //the max flight high the drone flies up
-                    while(read_current_altitude() <= 
-                            (altitude_start_position + delta_limited_high)) {
-                        
-                        //write function for the flight controller
-                        //to let the drone fly higher with a middle gas
-                        write_flight_controller(roll_value, pitch_middle_value, 
-                                yaw_middle_value, throttle_max_value);
-                    }
-                    //write function for the flight controller
-                    //to hold the current positon in the air
-                    write_flight_controller(roll_value,pitch_middle_value,
-                            yaw_middle_value, throttle_middle_value);
-                    
-                    //move to the next step of the takeoff process
-                    backflight_takeoff_process = 1;
-                    
-                    //end this case
-                    break;
-                }
-                
-                case(1): {  //case to rotate the drone in the right direction
-                    
-                    //while the cardinal direction is not in the direction
-                    //where the end position is
-                    while(azimuth <= (himmelsrichtung - compass_tolerance) || 
-                            azimuth >= (himmelsrichtung + compass_tolerance)) {
-                        
-                        //to allow the access to the structure
-                        single_satelite_data satelites[12];
-                        
-                        //this variable defines the amount of satellites 
-                        //which are connected with the the gps modul
-                        int amoutSatelites = 0;
-                        char buffer[128];
-                        
-                        //this for function will run the internal code 12 times
-                        for(int i = 0; i< 12; i++) {
-                            //read the received gps data from uart as long as
-                            //the right gps data are not there
-                            while(memcmp(receive_gps, satelite_prefix, 
-                                strlen(satelite_prefix)) != 0) {
-                                //read the received uart data from SERCOM3 GPS
-                                SERCOM3_USART_Read(receive_gps, 
-                                        sizeof(receive_gps));
-                            }
-                            
-                            //to get the satellites with the best connection
-                            //to the gps modul
-                            amoutSatelites = split_satelites_data(buffer, 
-                                    satelites);
-                            
-                            //when the gps modul has connected satellites
-                            //then calculate the direction (azimuth) of the gps
-                            if(amoutSatelites > 0) {
-                                azimuth = compass_direction(satelites, 
-                                        amoutSatelites);
-                            }
-                        }
-                        
-                        //write function for the flight controller 
-                        //to rotate right around in the air
-                        write_flight_controller(roll_value, pitch_middle_value, 
-                                1600, throttle_middle_value);
-                    }
-                    
-                    //write function for the flight controller
-                    //to hold the current positon in the air
-                    write_flight_controller(roll_value, pitch_middle_value, 
-                            yaw_middle_value, throttle_middle_value);
-                    
-                    //when the cardinal direction is in the tolerance range
-                    if(azimuth > (himmelsrichtung - compass_tolerance) || 
-                            azimuth < (himmelsrichtung + compass_tolerance)) {
-                        //move on to the next step of the full fligth process
-                        process_state = 6;
-                    }
-                    //end this case
-                    break;
-                }
-            }
-            
-            //end this case
-            break;
+        return state_payload;
+    }
+    if(payload == 0) {
+        return state_payload;
+    }
+    
+    //write over uart to the bluetooth modul, that the drone is ready for
+    //the flight
+    bluetooth_send((const char*)message_ready_to_start);
+    return state_compass;
+}
+
+static void payload_exit(void) {
+    timer_stop(TIMER_OVERWEIGHT);
+    load_cell_needed = false;
+}
+
+//state to calculate the direction of the compass with the next group of
+//satellite sentences
+static uint8_t compass_step(uint8_t events) {
+    if(!(events & event_satellites)) {
+        return state_compass;
+    }
+    
+    //the setup goes on when the satellites give a direction
+    const gps_satellite_table_t* satelites = gps_get_satellites();
+    if(satelites->count == 0 || compass_direction(satelites) < 0) {
+        return state_compass;
+    }
+    return state_start_signal;
+}
+
+//state to wait for the start signal from the user, with the next line the
+//setup is complete and the outbound leg starts
+static uint8_t start_signal_step(uint8_t events) {
+    if(!(events & event_bluetooth)) {
+        return state_start_signal;
+    }
+    
+    //when the received data contains the start signal in the message, then
+    //the microcontroller will tell the user that the flightprocess begins
+    if(memcmp(receive_bt, start_signal, sizeof(start_signal)) == 0) {
+        bluetooth_send((const char*)message_fly_starts);
+    }
+    
+    setup_complete = true;
+    current_leg = leg_outbound;
+    
+    //turn off the LED of the battery state
+    controll_LED_Clear();
+    return state_climb;
+}
+
+//state to climb with the altitude controller to the flight high above the
+//start position of the leg
+static void climb_enter(void) {
+    altitude_phase_enter(start_altitude + delta_limited_high, false);
+}
+
+static uint8_t climb_step(uint8_t events) {
+    if(!altitude_phase_step(events)) {
+        return state_climb;
+    }
+    
+    //the course over ground only shows the heading when the drone moves
+    return (heading_get_source() == HEADING_SOURCE_COURSE)
+            ? state_calibrate : state_align;
+}
+
+static void climb_exit(void) {
+    altitude_phase_exit();
+    
+    //hold the current positon in the air
+    write_flight_controller(roll_value, pitch_middle_value, yaw_middle_value,
+            throttle_middle_value);
+}
+
+//state to fly the drone forward for a short pulse, so the course over ground
+//shows the yaw of the drone before the alignment. The pulse ends when the
+//heading has converged or after the pulse time
+static void calibrate_enter(void) {
+    heading_reset();
+    timer_start(TIMER_STATE, heading_pulse_ms, false, NULL);
+    
+    //the output task repeats the command during the whole pulse
+    write_flight_controller(roll_value, pitch_course_value, yaw_middle_value,
+            throttle_middle_value);
+}
+
+static uint8_t calibrate_step(uint8_t events) {
+    if(events & event_fix) {
+        heading_update_course(gps_get_fix());
+    }
+    
+    if(heading_get_convergence_ms() == 0 && !(events & event_timer)) {
+        return state_calibrate;
+    }
+    return state_align;
+}
+
+static void calibrate_exit(void) {
+    //the pulse can end before the pulse time
+    timer_stop(TIMER_STATE);
+    
+    //tell the user the update rate and the convergence time of the heading
+    uint16_t rate = heading_get_rate();
+    uint32_t convergence_ms = heading_get_convergence_ms();
+    if(convergence_ms != 0) {
+        sprintf((char*)message_heading, "Kurs %u.%02u Hz Konvergenz %lu ms",
+                rate / 100, rate % 100, (unsigned long)convergence_ms);
+    } else {
+        sprintf((char*)message_heading, "Kurs %u.%02u Hz keine Konvergenz",
+                rate / 100, rate % 100);
+    }
+    bluetooth_send((const char*)message_heading);
+}
+
+//state to rotate the drone the shortest way into the direction of the leg
+//until the heading is inside the compass tolerance. With the course over
+//ground the drone flies forward during the alignment
+static void align_enter(void) {
+    alignment_overshoot = 0;
+    alignment_first_sample = true;
+    phase_start_ms = systime_get_ms();
+    
+    //the heading of the course over ground comes from the pulse before
+    if(heading_get_source() == HEADING_SOURCE_COURSE) {
+        alignment_pitch = pitch_course_value;
+    } else {
+        alignment_pitch = pitch_middle_value;
+        heading_reset();
+    }
+}
+
+static uint8_t align_step(uint8_t events) {
+    int32_t tolerance = compass_tolerance;
+    uint16_t heading;
+    
+    if(!sample_heading(events)) {
+        return state_align;
+    }
+    
+    //without a heading the drone goes on without rotation until the next
+    //sample
+    if(!heading_get(&heading)) {
+        write_flight_controller(roll_value, alignment_pitch, yaw_middle_value,
+                throttle_middle_value);
+        return state_align;
+    }
+    
+    //the bearing of the leg is in 1/100 degrees
+    int32_t error = heading_error(flight_leg.bearing, heading);
+    
+    //the overshoot is the biggest error to the other side of the target
+    //than the error at the start
+    if(alignment_first_sample) {
+        alignment_first_error = error;
+        alignment_first_sample = false;
+    } else if((alignment_first_error > 0 && error < 0)
+            || (alignment_first_error < 0 && error > 0)) {
+        uint16_t overshoot = (uint16_t)((error < 0) ? -error : error);
+        if(overshoot > alignment_overshoot) {
+            alignment_overshoot = overshoot;
         }
-        
-        case(6): {  //case for the flight to the end position
-            
-            //while the distance to the end position is bigger than 10meters the
-            //drone can fly faster to the position to save energy
-            while(read_current_distance() > 10.0) {
-                write_flight_controller(roll_value, 1700, yaw_middle_value,
-                        1700);
-            }
-            
-            //while the distance is less than 10.0 meters and higher or equal 2
-            //meters, the drone should fly slower to the end position
-            while(read_current_distance() <= 10.0 
-                    && read_current_distance() >= 2.0) {
-                write_flight_controller(roll_value, 1600, yaw_middle_value,
-                        1600);
-            }
-            
-            //while the distance is less than 2.0 meters and higher or equal 0.2
-            //meters, the drone should fly slower to the end position
-            //to land more precise at the exat end position
-            while(read_current_distance() >= 0.2 
-                    && read_current_distance() <= 2.0) {
-                write_flight_controller(roll_value, 1550, yaw_middle_value,
-                        1550);
-            }
-            
-            //when the drone is in a distance of the tolerance range of 0.2
-            //than stop in the air hold the position and move on to the 
-            //next flight process
-            if(read_current_distance() < 0.2) {
-                write_flight_controller(roll_value, 1500, yaw_middle_value,
-                        1500);
-                
-                //move to the next step of the flight process
-                process_state = 7;
-            }
-            
-            //end this case
-            break;
+    }
+    
+    if(error >= -tolerance && error <= tolerance) {
+        return state_leg;
+    }
+    
+    //rotate the shortest way, faster when the error is bigger
+    write_flight_controller(roll_value, alignment_pitch, yaw_command(error),
+            throttle_middle_value);
+    return state_align;
+}
+
+static void align_exit(void) {
+    alignment_time_ms = systime_get_ms() - phase_start_ms;
+    
+    //tell the user how long the alignment took, how far it overshot and
+    //how often the heading was updated
+    uint16_t rate = heading_get_rate();
+    sprintf((char*)message_alignment,
+            "Ausrichtung %lu ms Ueberschwingen %u.%02u Grad %u.%02u Hz",
+            (unsigned long)alignment_time_ms,
+            alignment_overshoot / 100, alignment_overshoot % 100,
+            rate / 100, rate % 100);
+    bluetooth_send((const char*)message_alignment);
+    
+    //hold the current positon in the air
+    write_flight_controller(roll_value, pitch_middle_value, yaw_middle_value,
+            throttle_middle_value);
+}
+
+//state to fly along the leg until the drone is inside the arrival tolerance
+//around the end position. Every pass of the navigation task is a control
+//tick, the along track controller sets the pitch from the way to the end
+//position and the cross track controller the roll from the error to the
+//line of the leg, both with the position of the predictor
+static void leg_enter(void) {
+    for(uint8_t i = 0; i < control_count; i++) {
+        pid_reset(&control_state[i]);
+    }
+    predictor_reset(&leg_predictor);
+    leg_max_cross_track = 0;
+    altitude_fix_ms = 0;
+    leg_start_ms = systime_get_ms();
+    leg_tick_ms = leg_start_ms;
+    
+    //the last fix was used by the state before, it is the first one of the
+    //predictor
+    correct_leg_position(gps_get_fix());
+}
+
+static uint8_t leg_step(uint8_t events) {
+    int32_t position[PREDICTOR_AXES];
+    uint32_t now_ms = systime_get_ms();
+    uint32_t delta_ms = now_ms - leg_tick_ms;
+    leg_tick_ms = now_ms;
+    
+    if(events & event_fix) {
+        correct_leg_position(gps_get_fix());
+    }
+    
+    //the position at this tick is predicted from the last fix, without any
+    //fix the drone can not be controlled yet
+    if(!predictor_predict(&leg_predictor, systime_get_us(), position)) {
+        return state_leg;
+    }
+    current_distance = geo_leg_distance(&flight_leg,
+            position[PREDICTOR_NORTH], position[PREDICTOR_EAST]);
+    geo_leg_track(&flight_leg, position[PREDICTOR_NORTH],
+            position[PREDICTOR_EAST], &current_along_track,
+            &current_cross_track);
+    
+    uint32_t cross = (current_cross_track < 0) ?
+            (uint32_t)-current_cross_track : (uint32_t)current_cross_track;
+    if(cross > leg_max_cross_track) {
+        leg_max_cross_track = cross;
+    }
+    
+    if(current_distance < arrival_tolerance) {
+        return state_descend;
+    }
+    
+    //the along track error is the way which is left to the end position and
+    //the cross track error has to be corrected to the left when the drone
+    //is right of the leg
+    int32_t pitch = pid_update(&control_parameter[control_along_track],
+            &control_state[control_along_track],
+            (int32_t)flight_leg.length - current_along_track, delta_ms);
+    int32_t roll = pid_update(&control_parameter[control_cross_track],
+            &control_state[control_cross_track],
+            -current_cross_track, delta_ms);
+    
+    //the altitude is held at the flight high and forwards and backwards the
+    //tilt needs more throttle
+    int32_t tilt = (pitch < 0) ? -pitch : pitch;
+    int32_t throttle = altitude_throttle(hold_altitude, -descent_speed,
+            climb_speed, delta_ms)
+            + ((tilt * pitch_throttle_feed_forward) >> 8);
+    if(throttle > throttle_max_value) {
+        throttle = throttle_max_value;
+    }
+    write_flight_controller(roll_value + roll, pitch_middle_value + pitch,
+            yaw_middle_value, throttle);
+    return state_leg;
+}
+
+static void leg_exit(void) {
+    leg_time_ms = systime_get_ms() - leg_start_ms;
+    leg_final_distance = current_distance;
+    leg_final_cross_track = current_cross_track;
+    
+    //the next read of the distance has to use the fix again
+    distance_sequence = 0;
+    
+    //tell the user how long the leg took and how precise the drone arrived
+    sprintf((char*)message_leg,
+            "Strecke %lu ms Abstand %lu cm Quer %ld cm Max %lu cm",
+            (unsigned long)leg_time_ms, (unsigned long)leg_final_distance,
+            (long)leg_final_cross_track, (unsigned long)leg_max_cross_track);
+    bluetooth_send((const char*)message_leg);
+    
+    //stop in the air and hold the position
+    write_flight_controller(roll_value, pitch_middle_value, yaw_middle_value,
+            throttle_middle_value);
+}
+
+//state to descend with the altitude controller to the start altitude, below
+//1 meter the descent is slower
+static void descend_enter(void) {
+    altitude_phase_enter(start_altitude, true);
+}
+
+static uint8_t descend_step(uint8_t events) {
+    return altitude_phase_step(events) ? state_ground : state_descend;
+}
+
+static void descend_exit(void) {
+    altitude_phase_exit();
+}
+
+//state to wait on the ground, the drone is 5cm or less away from the ground
+//so the throttle is set to the minimum start speed
+static void ground_enter(void) {
+    write_flight_controller(roll_value, pitch_middle_value, yaw_middle_value,
+            throttle_min_value);
+    timer_start(TIMER_STATE, leg_parameter[current_leg].ground_wait_ms,
+            false, NULL);
+}
+
+static uint8_t ground_step(uint8_t events) {
+    if(events & event_timer) {
+        return leg_parameter[current_leg].after_ground;
+    }
+    return state_ground;
+}
+
+//state to swap the start and the end position for the return leg with the
+//next fix on the ground
+static uint8_t return_position_step(uint8_t events) {
+    if(!(events & event_fix)) {
+        return state_return_position;
+    }
+    
+    //to safe the value of the start position between two steps
+    int32_t step_latitude = start_latitude;
+    int32_t step_longitude = start_longitude;
+    
+    //set the current position as the start coords
+    const gps_fix_t* fix = gps_get_fix();
+    start_latitude = fix->latitude;
+    start_longitude = fix->longitude;
+    
+    //set the safed values from the cache in for the end position because
+    //the drone has to fly back
+    end_latitude = step_latitude;
+    end_longitude = step_longitude;
+    
+    //change the start altitude to the altitude of the new position
+    start_altitude = fix->altitude;
+    
+    //build the north east frame of the leg back, the distance and the
+    //direction in which the drone has to fly
+    geo_leg_initialize(&flight_leg, start_latitude, start_longitude,
+            end_latitude, end_longitude);
+    distance_sequence = 0;
+    
+    current_leg = leg_return;
+    return state_return_payload;
+}
+
+//state to check if the payload is okay before the return leg
+static void return_payload_enter(void) {
+    load_cell_needed = true;
+}
+
+static uint8_t return_payload_step(uint8_t events) {
+    //the payload comes from the load cell task
+    if(payload != 0 && payload < max_weight) {
+        return state_climb;
+    }
+    return state_return_payload;
+}
+
+static void return_payload_exit(void) {
+    load_cell_needed = false;
+}
+
+//state to end the whole flight process
+static uint8_t end_step(uint8_t events) {
+    end_of_flight_process();
+    return state_coordinates;
+}
+
+//table of the states of the flight process, the index is the state
+const flight_state_t flight_states[state_count] = {
+    {"COORDS", coordinates_enter, coordinates_step, NULL},
+    {"START", NULL, start_position_step, NULL},
+    {"PAYLOAD", payload_enter, payload_step, payload_exit},
+    {"COMPASS", NULL, compass_step, NULL},
+    {"SIGNAL", NULL, start_signal_step, NULL},
+    {"CLIMB", climb_enter, climb_step, climb_exit},
+    {"PULSE", calibrate_enter, calibrate_step, calibrate_exit},
+    {"ALIGN", align_enter, align_step, align_exit},
+    {"LEG", leg_enter, leg_step, leg_exit},
+    {"DESCEND", descend_enter, descend_step, descend_exit},
+    {"GROUND", ground_enter, ground_step, NULL},
+    {"RETURN", NULL, return_position_step, NULL},
+    {"RELOAD", return_payload_enter, return_payload_step,
+            return_payload_exit},
+    {"END", NULL, end_step, NULL},
+};
+
+//this function collects the events for the flight process since its last
+//pass
+static uint8_t flight_events(void) {
+    uint8_t events = 0;
+    
+    if(gps_has_new_fix(&flight_fix_sequence)) {
+        events |= event_fix;
+    }
+    if(gps_has_new_satellite_epoch(&satelite_epoch)) {
+        events |= event_satellites;
+    }
+    if(timer_expired(TIMER_STATE)) {
+        events |= event_timer;
+    }
+    if(bluetooth_line_ready) {
+        events |= event_bluetooth;
+    }
+    return events;
+}
+
+//this function controlls the full fly protocol and the setup. Every pass
+//runs the step of the current state once with the new events and returns,
+//when the step returns another state the exit of the current state and at
+//the next pass the enter of the new state run. The time of every pass is
+//measured for the report
+void fly_process(void) {
+    uint8_t state = flight_state;
+    const flight_state_t* handler = &flight_states[state];
+    uint8_t events = flight_events();
+    uint32_t start_us = systime_get_us();
+    
+    if(!flight_state_entered) {
+        flight_state_entered = true;
+        if(handler->enter != NULL) {
+            handler->enter();
         }
-        
-        case(7): {
-            
-            //while the drone is landing and its high is higher than
-            //1 meter the drone can land faster than when the high is less than
-            //1 meter
-            while(read_current_altitude() > (altitude_start_position + 1)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, 1300);
-            }
-            
-            //while the drone is landing and its high is less than 1 meter
-            //the speed of landing has to be slower
-            while(read_current_altitude() <= (altitude_start_position + 1)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, 1400);
-            }
-            
-            //when the drone is 5cm or less away from the ground the drone
-            //set the throttle variable to the minimum start speed
-            if(read_current_altitude() < (altitude_start_position + 0.05)) {
-                write_flight_controller(roll_value, pitch_middle_value,
-                        yaw_middle_value, throttle_min_value);
-                
-                //Wait 10 seconds to end the whole flight process
-                delay_ms(10000);
-                
-                //call the function to end the whole flight process
-                end_of_flight_process();
-            }
-            
-            //end this case
-            break;
+    }
+    
+    uint8_t next = handler->step(events);
+    
+    //a line which the state has not used is thrown away, so the bluetooth
+    //task can read the next one
+    if(events & event_bluetooth) {
+        bluetooth_line_ready = false;
+        memset(receive_bt, 0, sizeof(receive_bt));
+    }
+    
+    if(next != state) {
+        if(handler->exit != NULL) {
+            handler->exit();
         }
+        flight_state = next;
+        flight_state_entered = false;
+    }
+    
+    uint32_t pass_us = systime_get_us() - start_us;
+    if(pass_us > flight_state_max_us[state]) {
+        flight_state_max_us[state] = pass_us;
     }
 }
\ No newline at end of file
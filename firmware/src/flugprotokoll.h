@@ -19,81 +19,80 @@
 #define _FLUGPROTOKOLL_H
 
 #include <stdint.h>
-
-//this function creates any milliseconds delay
-//useful to make sure that a function has been completed 
-//or to introduce a delay in the program flow.
-void delay_ms(uint16_t ms);
-
-//this function creates any microseconds delay
-//useful to make sure that a function has been completed 
-//or to introduce a delay in the program flow.
-void delay_us(uint16_t us);
+#include <stdbool.h>
+#include "gps.h"
 
 //this function resets all necessary variables for a restart flight process
 //and also to start a new process
 void change_flugprozess_variable(void);
 
-//To change the format from degrees minutes to degrees
-//The gps sends the positions in the degrees minutes format
-//so this has to be changed to degrees system
-double change_degree_minutes_to_degree(double tochange);
-
-//this function change a value in radians to a value in degrees
-//this is useful for the courseTO and distance function
-double radians_to_degrees(double rad);
-
-//this function change a value in degrees to a value in radians
-//this is useful for the courseTO and distance function
-double degrees_to_radians(double degrees);
-
-//this function calculates the distance between the start position and the end
-//position in meters.
-double distance(double start_lat, double start_lon, double end_lat, double end_lon);
-
-//this function calculates the angle for the cardinal direction in which
-//cardinal direction the drone has to fly from the start position to the
-//end position. The unit is in degrees
-double courseTO(double lat1, double lon1, double lat2, double lon2);
-
-//this is a datatype of 4 variables with the name
-//single_satelite_data
-//this is to safe for each connected satellite their data
-typedef struct {
-    int amount;
-    int elevation;
-    int azimuth;
-    int signal_strength;
-}single_satelite_data;
-
-//this function calculates the strenght of the signal of the gps modul
-//to the satellites in dB. This is necessary because to calculate the
-//cardinal direction, it would be better to use the data from the satellites
-//with the strongest connection
-int split_satelites_data(char* data, single_satelite_data* satelites);
-
-//this function calculates the cardinal direction of the drone
-//it will return a double in the unit degrees
-double compass_direction(single_satelite_data* satelites, int amountSatelites);
-
-//this function is for the calculation of the current high of the drone and has
-//to be a double be more precise. The unit is in meters
-double read_current_altitude(void);
-
-//this function calculates the current distance of the drone to the end position
-//unit of this is in meters and has to be a double because to be more precise
-double read_current_distance(void);
-
-//this function will return the current latitude in degrees
-double read_current_latitude(void);
-
-//this function will return the current longitude in degrees
-double read_current_longitude(void);
-
-//function to create the message which will be send over uart at SERCOM0
-//to the flight controller with the values of the roll, pitch, yaw and throttle
-void write_flight_controller(double roll, double pitch, double yaw, 
-        double throttle);
+//this function calculates the signed error from the heading to the target in
+//1/100 degrees, both are in 1/100 degrees. The error is wrapped into
+//-18000 to 17999 so it always points the shortest way, positive is right
+int32_t heading_error(uint16_t target, uint16_t heading);
+
+//this function calculates the yaw command for the heading error in 1/100
+//degrees, it is proportional to the error and limited to the yaw range
+int32_t yaw_command(int32_t error);
+
+//this function puts a message for the bluetooth modul into the queue, the
+//bluetooth task sends it when the uart is free. Returns false when the
+//queue is full and the message is lost
+bool bluetooth_send(const char* text);
+
+//this function selects the source of the heading with the bluetooth
+//message "$HEADING,COG" or "$HEADING,SAT" and tells the user the source
+void select_heading_source(const char* message);
+
+//this function updates the altitude estimate with the fix, the vertical speed
+//is the change of the altitude between two fixes divided by the time
+//between them and smoothed over about 4 fixes
+void update_altitude(const gps_fix_t* fix);
+
+//this function calculates the throttle to reach the target altitude in
+//millimetres. The altitude controller sets the vertical speed inside the
+//limits in millimetres per second and the vertical speed controller the
+//throttle around the middle value
+int32_t altitude_throttle(int32_t target, int32_t speed_min,
+        int32_t speed_max, uint32_t delta_ms);
+
+//this function sends the time to the first fix and to 8 satellites after the
+//start over bluetooth, with the age of the hot start position in minutes
+//and if the almanac of the gps modul was complete at the last flight
+void send_gps_start_report(const gps_fix_t* fix);
+
+//function to create the message which will be send over uart at SERCOM1
+//to the flight controller with the values of the roll, pitch, yaw and
+//throttle. The values are decimal integers separated by spaces and the line
+//ends with a line feed, like "1500 1750 1500 1250\n"
+void write_flight_controller(int32_t roll, int32_t pitch, int32_t yaw,
+        int32_t throttle);
+
+//this function is the output task to the flight controller. It sends a new
+//command at the rate of the task and repeats the last one when there was no
+//new command for the refresh time
+void flight_controller_task(void);
+
+//this function is the navigation task, it is released by the control tick
+//and runs the flight process while there is one
+void navigation_task(void);
+
+//this function is the bluetooth task. The report of the tasks and the
+//source of the heading are handled here at every time, all other lines are
+//given to the flight process. When the uart is free the next message of the
+//queue is sent, without one the lines of a report one after the other
+void bluetooth_task(void);
+
+//this function is the load cell task, it starts a read of the load cell
+//and takes the weight into the payload at the next run when the transfer
+//is finished. When the payload is not needed the clocks of the load cell
+//are switched off after the last transfer
+void load_cell_task(void);
+
+//this function is the logging task, during the flight it sends the state
+//of the flight process, the distance and the cross track error in cm, the
+//altitude in mm and the load of all tasks to the bluetooth modul
+void logging_task(void);
 
 //this function is for the end process and will be called when the flight
 //process is ready for the reset
@@ -107,7 +106,11 @@ bool get_fly_process();
 //boolean
 void set_fly_process(bool set);
 
-//this function controlls the full fly protocol and the setup
+//this function controlls the full fly protocol and the setup. Every pass
+//runs the step of the current state once with the new events and returns,
+//when the step returns another state the exit of the current state and at
+//the next pass the enter of the new state run. The time of every pass is
+//measured for the report
 void fly_process(void);
 
 
@@ -0,0 +1,238 @@
+/* ************************************************************************** */
+/** geo
+
+  @Company
+    Schindelar
+
+  @File Name
+    geo.c
+
+  @Summary
+    Integer geodesy for positions in 1e-7 degrees. The distance is the
+    equirectangular approximation with a cos(latitude) scale of the longitude
+    which is calculated once for every leg with the CORDIC. The bearing comes
+    from the CORDIC atan2 and the length from an integer square root, so the
+    control loop needs no soft float trigonometry.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "geo.h"
+#include "divas_math.h"
+#include "trig.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//accuracy tier of the CORDIC for the cos scale of a leg, it is calculated
+//only once for every leg but its error goes into every distance
+#define GEO_TIER_SCALE TRIG_TIER_0_001
+
+//accuracy tier of the CORDIC for the bearings and the directions
+#define GEO_TIER_DIRECTION TRIG_TIER_0_01
+
+//below this value the square root of the DIVAS with one newton step is used,
+//this are distances up to 83 km in centimetres
+#define GEO_ISQRT_REFINE_LIMIT (1ULL << 46)
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function calculates the centimetres of 1e-7 degrees longitude as Q16
+//with the cos scale of the leg
+static uint32_t geo_east_scale(uint16_t cos_scale) {
+    return (GEO_CM_PER_E7_Q16 * cos_scale + GEO_COS_ONE / 2) >> 15;
+}
+
+//this function changes a difference in 1e-7 degrees into centimetres with
+//a scale as Q16
+static int32_t geo_scale(int32_t delta, uint32_t scale) {
+    return (int32_t)(((int64_t)delta * scale + 0x8000) >> 16);
+}
+
+//this function calculates the integer square root bit by bit, it is only
+//needed for values which are too big for the DIVAS
+uint32_t geo_isqrt_bits(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while(bit > value) {
+        bit >>= 2;
+    }
+
+    while(bit != 0) {
+        if(value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function calculates cos(latitude) as Q15 for the scale of the
+//longitude, it only has to be calculated once for every leg with the mean
+//latitude of the leg
+uint16_t geo_cos_scale(int32_t latitude) {
+    int32_t sin, cos;
+
+    trig_sin_cos(trig_from_degrees_e7(latitude), GEO_TIER_SCALE, &sin, &cos);
+    if(cos <= 0) {
+        return 0;
+    }
+
+    //from Q30 into Q15
+    return (uint16_t)((cos + (1L << 14)) >> 15);
+}
+
+//this function changes a difference of the latitude into centimetres to the
+//north
+int32_t geo_north(int32_t delta_latitude) {
+    return geo_scale(delta_latitude, GEO_CM_PER_E7_Q16);
+}
+
+//this function changes a difference of the longitude into centimetres to the
+//east with the cos scale of the leg
+int32_t geo_east(int32_t delta_longitude, uint16_t cos_scale) {
+    return geo_scale(delta_longitude, geo_east_scale(cos_scale));
+}
+
+//this function calculates the distance in centimetres between two positions
+//with the cos scale of the leg
+uint32_t geo_distance(int32_t latitude1, int32_t longitude1,
+        int32_t latitude2, int32_t longitude2, uint16_t cos_scale) {
+    int64_t north = geo_north(latitude2 - latitude1);
+    int64_t east = geo_east(longitude2 - longitude1, cos_scale);
+
+    return geo_isqrt((uint64_t)(north * north) + (uint64_t)(east * east));
+}
+
+//this function calculates the bearing from the first to the second position
+//in 1/100 degrees, north is 0 and east is 9000
+uint16_t geo_bearing(int32_t latitude1, int32_t longitude1,
+        int32_t latitude2, int32_t longitude2, uint16_t cos_scale) {
+    int32_t north = geo_north(latitude2 - latitude1);
+    int32_t east = geo_east(longitude2 - longitude1, cos_scale);
+
+    //the bearing turns clockwise from the north, so the axes are swapped
+    return geo_atan2(east, north);
+}
+
+//this function builds the north east frame of the leg from the start to the
+//end position, the origin of the frame is the start position
+void geo_leg_initialize(geo_leg_t* leg, int32_t start_latitude,
+        int32_t start_longitude, int32_t end_latitude, int32_t end_longitude) {
+    //the scale of the longitude is taken at the mean latitude of the leg
+    uint16_t cos_scale = geo_cos_scale(start_latitude / 2 + end_latitude / 2);
+
+    leg->origin_latitude = start_latitude;
+    leg->origin_longitude = start_longitude;
+    leg->north_scale = GEO_CM_PER_E7_Q16;
+    leg->east_scale = geo_east_scale(cos_scale);
+
+    geo_leg_position(leg, end_latitude, end_longitude,
+            &leg->target_north, &leg->target_east);
+    leg->length = geo_leg_distance(leg, 0, 0);
+    leg->bearing = geo_atan2(leg->target_east, leg->target_north);
+
+    //the unit vector is needed for the cross track error, a leg without
+    //length points to the north
+    if(leg->length == 0) {
+        leg->unit_north = INT16_MAX;
+        leg->unit_east = 0;
+    } else {
+        leg->unit_north = (int16_t)(((int64_t)leg->target_north * INT16_MAX)
+                / (int64_t)leg->length);
+        leg->unit_east = (int16_t)(((int64_t)leg->target_east * INT16_MAX)
+                / (int64_t)leg->length);
+    }
+}
+
+//this function moves a position into the frame of the leg, north and east
+//are in centimetres from the start of the leg
+void geo_leg_position(const geo_leg_t* leg, int32_t latitude,
+        int32_t longitude, int32_t* north, int32_t* east) {
+    *north = geo_scale(latitude - leg->origin_latitude, leg->north_scale);
+    *east = geo_scale(longitude - leg->origin_longitude, leg->east_scale);
+}
+
+//this function calculates the distance in centimetres from a position in the
+//frame of the leg to the end of the leg
+uint32_t geo_leg_distance(const geo_leg_t* leg, int32_t north, int32_t east) {
+    int64_t delta_north = (int64_t)leg->target_north - north;
+    int64_t delta_east = (int64_t)leg->target_east - east;
+
+    return geo_isqrt((uint64_t)(delta_north * delta_north)
+            + (uint64_t)(delta_east * delta_east));
+}
+
+//this function calculates the way along the leg and the cross track error
+//in centimetres of a position in the frame of the leg, the cross track error
+//is positive when the position is right of the leg
+void geo_leg_track(const geo_leg_t* leg, int32_t north, int32_t east,
+        int32_t* along, int32_t* cross) {
+    *along = (int32_t)(((int64_t)north * leg->unit_north
+            + (int64_t)east * leg->unit_east) >> 15);
+    *cross = (int32_t)(((int64_t)east * leg->unit_north
+            - (int64_t)north * leg->unit_east) >> 15);
+}
+
+//this function calculates the angle of the vector (x, y) in 1/100 degrees
+//from 0 to 35999 like atan2(y, x), the angle of (0, 0) is 0
+uint16_t geo_atan2(int32_t y, int32_t x) {
+    return trig_to_centidegrees(trig_atan2(y, x, GEO_TIER_DIRECTION));
+}
+
+//this function calculates the integer square root, the result is rounded
+//down
+uint32_t geo_isqrt(uint64_t value) {
+    if(value <= UINT32_MAX) {
+        return divas_sqrt((uint32_t)value);
+    }
+    if(value >= GEO_ISQRT_REFINE_LIMIT) {
+        return geo_isqrt_bits(value);
+    }
+
+    //the DIVAS only takes 32 bits, so the value is shifted down by an even
+    //amount of bits and the root shifted up again. The missing bits are
+    //added with one newton step, the rest fits into 32 bits below the limit
+    uint8_t shift = 0;
+    while((value >> (2 * shift)) > UINT32_MAX) {
+        shift++;
+    }
+    uint32_t root = divas_sqrt((uint32_t)(value >> (2 * shift))) << shift;
+    uint32_t rest = (uint32_t)(value - (uint64_t)root * root);
+    root += divas_udivide(rest, 2 * root);
+
+    //the newton step can be one too high or too low
+    while((uint64_t)root * root > value) {
+        root--;
+    }
+    while((uint64_t)(root + 1) * (root + 1) <= value) {
+        root++;
+    }
+    return root;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/** geo
+
+  @Company
+    Schindelar
+
+  @File Name
+    geo.h
+
+  @Summary
+    Integer geodesy for positions in 1e-7 degrees, the distance and the
+    bearing between two positions without floating point and without libm
+ */
+/* ************************************************************************** */
+
+#ifndef _GEO_H    /* Guard against multiple inclusion */
+#define _GEO_H
+
+#include <stdint.h>
+
+//centimetres of 1e-7 degrees latitude as Q16, 111.19494 km per degree
+#define GEO_CM_PER_E7_Q16 72873UL
+
+//cos(latitude) as Q15, 32768 is 1.0
+#define GEO_COS_ONE 32768U
+
+//Accuracy between the latitudes -70 and 70 degrees for legs up to 10 km:
+//the distance differs from the exact equirectangular distance by less than
+//0.01 % plus 3 cm, the bearing from the great circle bearing of the old
+//courseTO() by less than 0.04 degrees up to 2 km and 0.13 degrees at 10 km
+//because the meridians are taken as parallel inside a leg
+
+//local north east frame of one leg, it is calculated once when the leg
+//starts and every fix is then only moved and scaled into it
+typedef struct {
+    int32_t origin_latitude;    //start of the leg in 1e-7 degrees
+    int32_t origin_longitude;
+    uint32_t north_scale;       //centimetres of 1e-7 degrees as Q16
+    uint32_t east_scale;
+    int32_t target_north;       //end of the leg in centimetres
+    int32_t target_east;
+    uint32_t length;            //length of the leg in centimetres
+    uint16_t bearing;           //bearing of the leg in 1/100 degrees
+    int16_t unit_north;         //direction of the leg as Q15 unit vector
+    int16_t unit_east;
+} geo_leg_t;
+
+//this function calculates cos(latitude) as Q15 for the scale of the
+//longitude, it only has to be calculated once for every leg with the mean
+//latitude of the leg
+uint16_t geo_cos_scale(int32_t latitude);
+
+//this function changes a difference of the latitude into centimetres to the
+//north
+int32_t geo_north(int32_t delta_latitude);
+
+//this function changes a difference of the longitude into centimetres to the
+//east with the cos scale of the leg
+int32_t geo_east(int32_t delta_longitude, uint16_t cos_scale);
+
+//this function calculates the distance in centimetres between two positions
+//with the cos scale of the leg
+uint32_t geo_distance(int32_t latitude1, int32_t longitude1,
+        int32_t latitude2, int32_t longitude2, uint16_t cos_scale);
+
+//this function calculates the bearing from the first to the second position
+//in 1/100 degrees, north is 0 and east is 9000
+uint16_t geo_bearing(int32_t latitude1, int32_t longitude1,
+        int32_t latitude2, int32_t longitude2, uint16_t cos_scale);
+
+//this function builds the north east frame of the leg from the start to the
+//end position, the origin of the frame is the start position
+void geo_leg_initialize(geo_leg_t* leg, int32_t start_latitude,
+        int32_t start_longitude, int32_t end_latitude, int32_t end_longitude);
+
+//this function moves a position into the frame of the leg, north and east
+//are in centimetres from the start of the leg
+void geo_leg_position(const geo_leg_t* leg, int32_t latitude,
+        int32_t longitude, int32_t* north, int32_t* east);
+
+//this function calculates the distance in centimetres from a position in the
+//frame of the leg to the end of the leg
+uint32_t geo_leg_distance(const geo_leg_t* leg, int32_t north, int32_t east);
+
+//this function calculates the way along the leg and the cross track error
+//in centimetres of a position in the frame of the leg, the cross track error
+//is positive when the position is right of the leg
+void geo_leg_track(const geo_leg_t* leg, int32_t north, int32_t east,
+        int32_t* along, int32_t* cross);
+
+//this function calculates the angle of the vector (x, y) in 1/100 degrees
+//from 0 to 35999 like atan2(y, x), the angle of (0, 0) is 0
+uint16_t geo_atan2(int32_t y, int32_t x);
+
+//this function calculates the integer square root, the result is rounded
+//down
+uint32_t geo_isqrt(uint64_t value);
+
+//this function calculates the integer square root bit by bit without the
+//DIVAS, geo_isqrt only uses it for values which are too big for the DIVAS
+uint32_t geo_isqrt_bits(uint64_t value);
+
+#endif /* _GEO_H */
+
+/* *****************************************************************************
+ End of File
+ */
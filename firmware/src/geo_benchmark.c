@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/** geo_benchmark
+
+  @Company
+    Schindelar
+
+  @File Name
+    geo_benchmark.c
+
+  @Summary
+    Cycles of the integer geodesy against the soft float functions which it
+    replaced. The per fix path of the leg, geo_leg_position, geo_leg_distance
+    and geo_leg_track, runs for every fix and every control tick, the frame
+    of the leg with geo_cos_scale only once for every leg, so both are
+    measured on their own. The reference is a copy of the old distance() and
+    courseTO() of the flight process, the Cortex M0+ has no floating point
+    unit, so every double operation calls a function of libgcc and libm.
+    One call of the old functions takes longer than one period of the
+    SysTick, so the milliseconds of the system time count the wraps
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <math.h>
+#include "definitions.h"
+#include "geo_benchmark.h"
+#include "geo.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of calls of every kind in the benchmark
+#define GEO_BENCHMARK_COUNT 8
+
+//the constants of the old functions
+#define GEO_OLD_TWO_PI (2 * M_PI)
+#define GEO_OLD_LATITUDE_DISTANCE 111.19494
+#define GEO_OLD_ONE_DEGREE_IN_RADIANS 0.01745
+
+//a leg of about 1 km at the HTL and a fix near its middle in 1e-7 degrees
+static volatile int32_t geo_benchmark_start[2] = {480739670, 162904615};
+static volatile int32_t geo_benchmark_end[2] = {480803000, 162990000};
+static volatile int32_t geo_benchmark_fix[2] = {480770000, 162950000};
+
+//cycles of one call measured by geo_benchmark
+static geo_benchmark_t geo_benchmark_result;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns the cpu cycles since the start of the system time,
+//the SysTick counts down with the cpu clock and the milliseconds count its
+//wraps. When the SysTick interrupt comes between the two reads they are
+//taken again
+static uint64_t geo_benchmark_cycles(void) {
+    uint32_t ms;
+    uint32_t ticks;
+
+    do {
+        ms = systime_get_ms();
+        ticks = SysTick->VAL;
+    } while(ms != systime_get_ms());
+
+    uint32_t load = SysTick->LOAD;
+    return (uint64_t)ms * (load + 1) + (load - ticks);
+}
+
+//the old distance() of the flight process in metres, unchanged
+static double geo_old_distance(double start_lat, double start_lon,
+        double end_lat, double end_lon) {
+    double latitude_mean = (start_lat + end_lat) / 2
+            * GEO_OLD_ONE_DEGREE_IN_RADIANS;
+    double dx = GEO_OLD_LATITUDE_DISTANCE * cos(latitude_mean)
+            * (start_lon - end_lon);
+    double dy = GEO_OLD_LATITUDE_DISTANCE * (start_lat - end_lat);
+
+    return sqrt(dx * dx + dy * dy) * 1000;
+}
+
+//the old courseTO() of the flight process in degrees, unchanged
+static double geo_old_course(double lat1, double lon1, double lat2,
+        double lon2) {
+    double dlon = (lon2 - lon1) * M_PI / 180;
+    lat1 = lat1 * M_PI / 180;
+    lat2 = lat2 * M_PI / 180;
+    double tangency = sin(dlon) * cos(lat2);
+    double partial = sin(lat1) * cos(lat2) * cos(dlon);
+    partial = cos(lat1) * sin(lat2) - partial;
+    double direction_radiant = atan2(tangency, partial);
+    if(direction_radiant < 0.0) {
+        direction_radiant += GEO_OLD_TWO_PI;
+    }
+    return direction_radiant * 180.0 / M_PI;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function measures the cpu cycles of the integer geodesy of one fix
+//along a leg, of the frame of one leg and of the soft float distance() and
+//courseTO() of the same fix. The positions are volatile, so the compiler can
+//not calculate the results before
+void geo_benchmark(void) {
+    volatile int32_t result;
+    volatile double old_result;
+    geo_leg_t leg;
+
+    //the loop with the loads of the positions is subtracted
+    uint64_t start = geo_benchmark_cycles();
+    for(uint8_t i = 0; i < GEO_BENCHMARK_COUNT; i++) {
+        result = geo_benchmark_fix[0] + geo_benchmark_fix[1];
+    }
+    uint32_t loop = (uint32_t)(geo_benchmark_cycles() - start);
+
+    start = geo_benchmark_cycles();
+    for(uint8_t i = 0; i < GEO_BENCHMARK_COUNT; i++) {
+        geo_leg_initialize(&leg, geo_benchmark_start[0],
+                geo_benchmark_start[1], geo_benchmark_end[0],
+                geo_benchmark_end[1]);
+    }
+    uint32_t setup = (uint32_t)(geo_benchmark_cycles() - start);
+
+    start = geo_benchmark_cycles();
+    for(uint8_t i = 0; i < GEO_BENCHMARK_COUNT; i++) {
+        int32_t north, east, along, cross;
+        geo_leg_position(&leg, geo_benchmark_fix[0], geo_benchmark_fix[1],
+                &north, &east);
+        result = (int32_t)geo_leg_distance(&leg, north, east);
+        geo_leg_track(&leg, north, east, &along, &cross);
+        result = along + cross;
+    }
+    uint32_t fix = (uint32_t)(geo_benchmark_cycles() - start);
+
+    start = geo_benchmark_cycles();
+    for(uint8_t i = 0; i < GEO_BENCHMARK_COUNT; i++) {
+        double latitude = geo_benchmark_fix[0] / 1e7;
+        double longitude = geo_benchmark_fix[1] / 1e7;
+        double end_latitude = geo_benchmark_end[0] / 1e7;
+        double end_longitude = geo_benchmark_end[1] / 1e7;
+        old_result = geo_old_distance(latitude, longitude, end_latitude,
+                end_longitude) + geo_old_course(latitude, longitude,
+                end_latitude, end_longitude);
+    }
+    uint32_t old = (uint32_t)(geo_benchmark_cycles() - start);
+    (void)result;
+    (void)old_result;
+
+    geo_benchmark_result.leg_cycles = (setup - loop) / GEO_BENCHMARK_COUNT;
+    geo_benchmark_result.fix_cycles = (fix - loop) / GEO_BENCHMARK_COUNT;
+    geo_benchmark_result.old_cycles = (old - loop) / GEO_BENCHMARK_COUNT;
+}
+
+//this function returns the result of the last benchmark, it is 0 before the
+//first benchmark
+const geo_benchmark_t* geo_get_benchmark(void) {
+    return &geo_benchmark_result;
+}
+
+/* *****************************************************************************
+ End of File
+ */
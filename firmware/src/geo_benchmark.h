@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/** geo_benchmark
+
+  @Company
+    Schindelar
+
+  @File Name
+    geo_benchmark.h
+
+  @Summary
+    Cycles of the integer geodesy of one fix and of one leg against the soft
+    float distance() and courseTO() which the flight process used before
+ */
+/* ************************************************************************** */
+
+#ifndef _GEO_BENCHMARK_H    /* Guard against multiple inclusion */
+#define _GEO_BENCHMARK_H
+
+#include <stdint.h>
+
+//cpu cycles of one call, measured with the SysTick
+typedef struct {
+    uint32_t fix_cycles;    //geo_leg_position, geo_leg_distance and
+                            //geo_leg_track of one fix
+    uint32_t leg_cycles;    //geo_leg_initialize of one leg
+    uint32_t old_cycles;    //the soft float distance() and courseTO()
+} geo_benchmark_t;
+
+//this function measures the cpu cycles of the integer geodesy of one fix
+//along a leg, of the frame of one leg and of the soft float distance() and
+//courseTO() of the same fix. The positions are volatile, so the compiler can
+//not calculate the results before
+void geo_benchmark(void);
+
+//this function returns the result of the last benchmark, it is 0 before the
+//first benchmark
+const geo_benchmark_t* geo_get_benchmark(void);
+
+#endif /* _GEO_BENCHMARK_H */
+
+/* *****************************************************************************
+ End of File
+ */
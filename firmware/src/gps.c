@@ -0,0 +1,960 @@
+/* ************************************************************************** */
+/** gps
+
+  @Company
+    Schindelar
+
+  @File Name
+    gps.c
+
+  @Summary
+    Interrupt driven receive path for the gps modul at SERCOM3.
+    Every received byte is handled in the receive interrupt and the stream is
+    split at '$' and "\r\n" into complete sentences in a small pool of line
+    buffers. Sentence types which are not required are dropped already in the
+    interrupt. The main loop picks up the finished sentences without blocking.
+    With GPS_PROTOCOL_UBX the position comes from binary NAV-PVT frames, they
+    are assembled and checked in the same interrupt and share the line pool.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <string.h>
+#include "definitions.h"
+#include "gps.h"
+#include "nmea.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//pool of line buffers, the receive interrupt writes at the write index and
+//the main loop reads at the read index
+static char gps_lines[GPS_LINE_COUNT][GPS_LINE_LENGTH];
+
+//receive time of every line in microseconds, taken in the interrupt at the
+//'$' or first sync character and at the line ending or checksum
+static uint32_t gps_line_start_us[GPS_LINE_COUNT];
+static uint32_t gps_line_end_us[GPS_LINE_COUNT];
+
+//both indices are running free, the slot is the index masked with the
+//GPS_LINE_COUNT. Only the interrupt changes the write index and only the
+//main loop changes the read index
+static volatile uint8_t gps_write_index = 0;
+static volatile uint8_t gps_read_index = 0;
+
+//state of the line which is assembled at the moment
+static uint8_t gps_line_length = 0;
+static bool gps_line_active = false;
+
+//the receive filter, the firmware only needs the GGA, GSV, RMC and VTG
+//sentences
+//all other sentences are dropped in the interrupt after the first 6 characters
+//the last entry counts all sentence types which are not in the list
+//with the UBX protocol the position does not come from the GGA sentences
+static gps_sentence_filter_t gps_sentence_filter[] = {
+    {"GGA", GPS_PROTOCOL == GPS_PROTOCOL_NMEA, 0, 0},
+    {"GSV", true, 0, 0},
+    {"GSA", false, 0, 0},
+    {"RMC", GPS_PROTOCOL == GPS_PROTOCOL_NMEA, 0, 0},
+    {"VTG", GPS_PROTOCOL == GPS_PROTOCOL_NMEA, 0, 0},
+    {"GLL", false, 0, 0},
+    {"TXT", false, 0, 0},
+    {"", false, 0, 0},
+};
+
+#define GPS_FILTER_COUNT (sizeof(gps_sentence_filter) / sizeof(gps_sentence_filter[0]))
+#define GPS_FILTER_OTHER (GPS_FILTER_COUNT - 1)
+
+//every bit is an entry of the filter list which still matches the received
+//characters of the sentence type
+static uint8_t gps_filter_candidates = 0;
+
+//true while the bytes of a dropped sentence are coming in
+static bool gps_line_dropped = false;
+static volatile uint32_t gps_dropped_bytes = 0;
+
+//baud rates which will be tried one after the other when the gps modul
+//does not answer, the first one is the factory setting
+static const uint32_t gps_baud_rates[] = {9600, GPS_BAUD_RATE, 38400, 57600, 19200};
+
+//the current baud rate of SERCOM3
+static uint32_t gps_baud_rate = 9600;
+
+//the messages of the gps modul with their class, id and output rate, this
+//is directly the payload of UBX-CFG-MSG. Only the position (GGA or NAV-PVT)
+//GSV, the date of RMC and the course over ground of VTG are required, all
+//others will be switched off
+static const uint8_t gps_message_rates[][3] = {
+    {0xF0, 0x00, GPS_PROTOCOL == GPS_PROTOCOL_NMEA},    //GGA
+    {0xF0, 0x01, 0},                                    //GLL
+    {0xF0, 0x02, 0},                                    //GSA
+    {0xF0, 0x03, GPS_SATELLITE_DIVIDER},                //GSV
+    {0xF0, 0x04, (GPS_PROTOCOL == GPS_PROTOCOL_NMEA) * GPS_DATE_DIVIDER}, //RMC
+    {0xF0, 0x05, GPS_PROTOCOL == GPS_PROTOCOL_NMEA},    //VTG
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+    {0x01, 0x07, 1},                                    //NAV-PVT
+#endif
+};
+
+//buffer for the ubx configuration messages, it has to stay valid until
+//the plib has sent the last byte
+static uint8_t gps_transmit_buffer[GPS_UBX_MAX_PAYLOAD + 8];
+
+//measurement of the GGA rate
+static uint32_t gps_rate_window_start = 0;
+static uint16_t gps_rate_window_count = 0;
+static uint16_t gps_fix_rate = 0;
+
+//date of the last RMC sentence as ddmmyy, 0 when it is not known
+static uint32_t gps_date = 0;
+
+//speed and course of the last VTG sentence, the modul sends it before the
+//GGA sentence of the same update, so it is added to the next fix
+static nmea_vtg_t gps_vtg = {false, 0, -1};
+
+//system time in ms of the first fix and of the first fix with
+//GPS_GOOD_SATELLITES, 0 when it has not happened yet
+static uint32_t gps_first_fix_ms = 0;
+static uint32_t gps_good_satellites_ms = 0;
+
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+//class, id and length of a NAV-PVT frame
+#define GPS_UBX_NAV_PVT_LENGTH 92
+#define GPS_UBX_HEADER_LENGTH 4
+
+//longest payload of a frame which is read to its end, the modul sends no
+//longer frames with this configuration. A bigger length comes from a broken
+//header and would hide the next frames, so the assembly starts again
+#define GPS_UBX_MAX_LENGTH 512
+
+#if GPS_LINE_LENGTH < (GPS_UBX_HEADER_LENGTH + GPS_UBX_NAV_PVT_LENGTH)
+#error "GPS_LINE_LENGTH is too short for a NAV-PVT frame"
+#endif
+
+//states of the ubx frame assembly, GPS_UBX_IDLE means there is no frame
+enum {
+    GPS_UBX_IDLE,
+    GPS_UBX_SYNC,
+    GPS_UBX_HEADER,
+    GPS_UBX_PAYLOAD,
+    GPS_UBX_CHECKSUM_A,
+    GPS_UBX_CHECKSUM_B,
+};
+
+//state of the ubx frame which is assembled at the moment, the header is
+//stored in the line slot only when the frame will be kept
+static uint8_t gps_ubx_state = GPS_UBX_IDLE;
+static uint8_t gps_ubx_header[GPS_UBX_HEADER_LENGTH];
+static uint16_t gps_ubx_position = 0;
+static uint16_t gps_ubx_length = 0;
+static uint8_t gps_ubx_checksum_a = 0;
+static uint8_t gps_ubx_checksum_b = 0;
+static bool gps_ubx_stored = false;
+static uint32_t gps_ubx_start_us = 0;
+#endif
+
+//the plib reads every byte into this variable
+static uint8_t gps_receive_byte = 0;
+
+//counter of all lost sentences
+static volatile uint32_t gps_lost_sentences = 0;
+
+//the last published fix
+static gps_fix_t gps_fix;
+
+//table of the satellites in view
+static gps_satellite_table_t gps_satellites;
+
+//talkers of the constellations in the order of GPS_CONSTELLATION_...
+static const char gps_constellation_talker[GPS_CONSTELLATION_OTHER][3] = {
+    "GP", "GL", "GA", "GB",
+};
+
+//every constellation has its own GSV group, the group number is increased
+//at the first sentence of a group and next_message is the expected message
+//number of the group, 0 means that the first sentence is missing
+static uint8_t gps_gsv_group[GPS_CONSTELLATION_COUNT];
+static uint8_t gps_gsv_next_message[GPS_CONSTELLATION_COUNT];
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Receive interrupt                                                 */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function is called for the characters 1 to 5 of a sentence and
+//compares them byte by byte with the filter list. After the 5th character
+//the sentence type is known and the sentence will be kept or dropped.
+//returns false when the sentence has to be dropped
+static bool gps_filter_byte(uint8_t position, uint8_t data) {
+    //the talker has to be two capital letters
+    if(position < 3) {
+        return data >= 'A' && data <= 'Z';
+    }
+
+    for(uint8_t i = 0; i < GPS_FILTER_OTHER; i++) {
+        if(gps_sentence_filter[i].type[position - 3] != (char)data) {
+            gps_filter_candidates &= (uint8_t)~(1U << i);
+        }
+    }
+
+    if(position < 5) {
+        return true;
+    }
+
+    //the sentence type is complete, only one candidate can be left
+    uint8_t entry = GPS_FILTER_OTHER;
+    for(uint8_t i = 0; i < GPS_FILTER_OTHER; i++) {
+        if(gps_filter_candidates & (1U << i)) {
+            entry = i;
+            break;
+        }
+    }
+
+    if(gps_sentence_filter[entry].accepted) {
+        gps_sentence_filter[entry].accepted_count++;
+        return true;
+    }
+    gps_sentence_filter[entry].dropped_count++;
+    return false;
+}
+
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+//this function is called for every byte of an ubx frame. The frame is read
+//to its end with the length of the header, so binary data in the payload
+//can not start a new sentence. Only NAV-PVT frames are kept
+static void gps_handle_ubx_byte(uint8_t data) {
+    uint8_t slot = gps_write_index & (GPS_LINE_COUNT - 1);
+    uint8_t* frame = (uint8_t*)gps_lines[slot];
+
+    switch(gps_ubx_state) {
+        case(GPS_UBX_SYNC): {
+            gps_ubx_state = (data == 0x62) ? GPS_UBX_HEADER : GPS_UBX_IDLE;
+            gps_ubx_position = 0;
+            gps_ubx_checksum_a = 0;
+            gps_ubx_checksum_b = 0;
+            break;
+        }
+
+        case(GPS_UBX_HEADER): {
+            gps_ubx_checksum_a += data;
+            gps_ubx_checksum_b += gps_ubx_checksum_a;
+            gps_ubx_header[gps_ubx_position++] = data;
+            if(gps_ubx_position < GPS_UBX_HEADER_LENGTH) {
+                break;
+            }
+
+            gps_ubx_length = (uint16_t)(gps_ubx_header[2]
+                    | (gps_ubx_header[3] << 8));
+            gps_ubx_position = 0;
+            if(gps_ubx_length > GPS_UBX_MAX_LENGTH) {
+                gps_lost_sentences++;
+                gps_ubx_state = GPS_UBX_IDLE;
+                break;
+            }
+            gps_ubx_stored = gps_ubx_header[0] == 0x01
+                    && gps_ubx_header[1] == 0x07
+                    && gps_ubx_length == GPS_UBX_NAV_PVT_LENGTH;
+
+            if(gps_ubx_stored) {
+                //when all line buffers are full the frame has to be dropped
+                if((uint8_t)(gps_write_index - gps_read_index) >= GPS_LINE_COUNT) {
+                    gps_ubx_stored = false;
+                    gps_lost_sentences++;
+                } else {
+                    memcpy(frame, gps_ubx_header, GPS_UBX_HEADER_LENGTH);
+                    gps_line_start_us[slot] = gps_ubx_start_us;
+                }
+            } else {
+                gps_dropped_bytes += GPS_UBX_HEADER_LENGTH + 4U + gps_ubx_length;
+            }
+
+            gps_ubx_state = gps_ubx_length > 0 ?
+                    GPS_UBX_PAYLOAD : GPS_UBX_CHECKSUM_A;
+            break;
+        }
+
+        case(GPS_UBX_PAYLOAD): {
+            gps_ubx_checksum_a += data;
+            gps_ubx_checksum_b += gps_ubx_checksum_a;
+            if(gps_ubx_stored) {
+                frame[GPS_UBX_HEADER_LENGTH + gps_ubx_position] = data;
+            }
+            if(++gps_ubx_position >= gps_ubx_length) {
+                gps_ubx_state = GPS_UBX_CHECKSUM_A;
+            }
+            break;
+        }
+
+        case(GPS_UBX_CHECKSUM_A): {
+            if(data != gps_ubx_checksum_a) {
+                gps_ubx_stored = false;
+                gps_lost_sentences++;
+            }
+            gps_ubx_state = GPS_UBX_CHECKSUM_B;
+            break;
+        }
+
+        default: {  //GPS_UBX_CHECKSUM_B
+            if(gps_ubx_stored && data == gps_ubx_checksum_b) {
+                gps_line_end_us[slot] = systime_get_us();
+
+                //the frame has to be written completely before the index
+                //changes
+                __DMB();
+                gps_write_index++;
+            } else if(gps_ubx_stored) {
+                gps_lost_sentences++;
+            }
+            gps_ubx_stored = false;
+            gps_ubx_state = GPS_UBX_IDLE;
+            break;
+        }
+    }
+}
+#endif
+
+//this function is called for every received byte and assembles the lines
+static void gps_handle_byte(uint8_t data) {
+    uint8_t slot = gps_write_index & (GPS_LINE_COUNT - 1);
+    char* line = gps_lines[slot];
+
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+    //the first sync character can not be in a nmea sentence because they
+    //are ascii only, it starts an ubx frame
+    if(gps_ubx_state == GPS_UBX_IDLE && data == 0xB5) {
+        if(gps_line_active) {
+            gps_line_active = false;
+            gps_lost_sentences++;
+        }
+        gps_line_dropped = false;
+        gps_ubx_state = GPS_UBX_SYNC;
+        gps_ubx_start_us = systime_get_us();
+        return;
+    }
+    if(gps_ubx_state != GPS_UBX_IDLE) {
+        gps_handle_ubx_byte(data);
+        return;
+    }
+#endif
+
+    //a '$' always starts a new sentence
+    if(data == '$') {
+        //the last sentence had no line ending so it is lost
+        if(gps_line_active) {
+            gps_lost_sentences++;
+        }
+        gps_line_dropped = false;
+
+        //when all line buffers are full the new sentence has to be dropped
+        if((uint8_t)(gps_write_index - gps_read_index) >= GPS_LINE_COUNT) {
+            gps_line_active = false;
+            gps_lost_sentences++;
+            return;
+        }
+
+        gps_line_start_us[slot] = systime_get_us();
+        line[0] = '$';
+        gps_line_length = 1;
+        gps_line_active = true;
+        gps_filter_candidates = (uint8_t)((1U << GPS_FILTER_OTHER) - 1);
+        return;
+    }
+
+    //all bytes between two sentences will be ignored
+    if(!gps_line_active || data == '\r') {
+        if(gps_line_dropped) {
+            gps_dropped_bytes++;
+        }
+        return;
+    }
+
+    //the line ending finishes the sentence and gives it to the main loop
+    if(data == '\n') {
+        gps_line_end_us[slot] = systime_get_us();
+        line[gps_line_length] = '\0';
+        gps_line_active = false;
+
+        //the line has to be written completely before the index changes
+        __DMB();
+        gps_write_index++;
+        return;
+    }
+
+    //the address of the sentence decides if the sentence is required
+    if(gps_line_length < 6 && !gps_filter_byte(gps_line_length, data)) {
+        gps_line_active = false;
+        gps_line_dropped = true;
+        gps_dropped_bytes += gps_line_length + 1U;
+        return;
+    }
+
+    //a line which is too long can not be a valid sentence
+    if(gps_line_length >= (GPS_LINE_LENGTH - 1)) {
+        gps_line_active = false;
+        gps_lost_sentences++;
+        return;
+    }
+
+    line[gps_line_length++] = (char)data;
+}
+
+//this callback is called by the plib from the SERCOM3 interrupt after every
+//received byte or after an uart error
+static void gps_receive_callback(uintptr_t context) {
+    if(SERCOM3_USART_ErrorGet() != USART_ERROR_NONE) {
+        //the byte is broken so the current sentence is lost
+        if(gps_line_active) {
+            gps_line_active = false;
+            gps_lost_sentences++;
+        }
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+        if(gps_ubx_state != GPS_UBX_IDLE) {
+            gps_ubx_state = GPS_UBX_IDLE;
+            if(gps_ubx_stored) {
+                gps_ubx_stored = false;
+                gps_lost_sentences++;
+            }
+        }
+#endif
+    } else {
+        gps_handle_byte(gps_receive_byte);
+    }
+
+    //start the read of the next byte directly in the interrupt, so no
+    //byte gets lost between two reads
+    SERCOM3_USART_Read(&gps_receive_byte, 1);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Configuration of the gps modul                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function waits until the last message has been sent completely
+static void gps_wait_transmit(void) {
+    while(SERCOM3_USART_WriteIsBusy());
+    while(!SERCOM3_USART_TransmitComplete());
+}
+
+//this function sends a ubx message with its fletcher checksum to the modul
+//the payload can have up to GPS_UBX_MAX_PAYLOAD bytes
+void gps_send_ubx(uint8_t message_class, uint8_t message_id,
+        const uint8_t* payload, uint16_t length) {
+    uint8_t checksum_a = 0;
+    uint8_t checksum_b = 0;
+
+    if(length > GPS_UBX_MAX_PAYLOAD) {
+        return;
+    }
+
+    while(SERCOM3_USART_WriteIsBusy());
+
+    gps_transmit_buffer[0] = 0xB5;
+    gps_transmit_buffer[1] = 0x62;
+    gps_transmit_buffer[2] = message_class;
+    gps_transmit_buffer[3] = message_id;
+    gps_transmit_buffer[4] = (uint8_t)length;
+    gps_transmit_buffer[5] = (uint8_t)(length >> 8);
+    memcpy(&gps_transmit_buffer[6], payload, length);
+
+    //the checksum goes over the class, id, length and payload
+    for(uint16_t i = 2; i < length + 6U; i++) {
+        checksum_a += gps_transmit_buffer[i];
+        checksum_b += checksum_a;
+    }
+    gps_transmit_buffer[length + 6U] = checksum_a;
+    gps_transmit_buffer[length + 7U] = checksum_b;
+
+    SERCOM3_USART_Write(gps_transmit_buffer, length + 8U);
+}
+
+//this function changes the baud rate of SERCOM3
+static bool gps_set_baud_rate(uint32_t baud_rate) {
+    USART_SERIAL_SETUP setup = {
+        .baudRate = baud_rate,
+        .parity = USART_PARITY_NONE,
+        .dataWidth = USART_DATA_8_BIT,
+        .stopBits = USART_STOP_1_BIT,
+    };
+
+    //the plib does not change the setup while a read is running
+    SERCOM3_USART_ReadAbort();
+    bool changed = SERCOM3_USART_SerialSetup(&setup, 0);
+    if(changed) {
+        gps_baud_rate = baud_rate;
+    }
+
+    //the current line was received with the old baud rate
+    gps_line_active = false;
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+    gps_ubx_state = GPS_UBX_IDLE;
+    gps_ubx_stored = false;
+#endif
+    SERCOM3_USART_Read(&gps_receive_byte, 1);
+
+    return changed;
+}
+
+//this function waits for a sentence with a valid checksum
+//returns false when there was no sentence within the timeout
+static bool gps_wait_for_sentence(uint32_t timeout_ms) {
+    uint32_t start = systime_get_ms();
+    nmea_sentence_t sentence;
+    const char* line;
+
+    while((systime_get_ms() - start) < timeout_ms) {
+        while((line = gps_peek_sentence()) != NULL) {
+            //the checksum of ubx frames is already checked in the interrupt
+            bool valid = (line[0] != '$') || nmea_tokenize(line, &sentence);
+            gps_release_sentence();
+            if(valid) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//this function tries all baud rates until the modul answers
+//the modul sends at least one GGA every second, so 1500ms are enough
+static bool gps_search_baud_rate(void) {
+    if(gps_wait_for_sentence(1500)) {
+        return true;
+    }
+
+    for(uint8_t i = 0; i < sizeof(gps_baud_rates) / sizeof(gps_baud_rates[0]); i++) {
+        gps_set_baud_rate(gps_baud_rates[i]);
+        if(gps_wait_for_sentence(1500)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//this function configures the gps modul after the start. It searches the
+//baud rate of the modul, sets the sentence mask, the update rate and
+//switches the modul and SERCOM3 to GPS_BAUD_RATE.
+//returns false when the modul does not answer at any baud rate
+bool gps_configure(void) {
+    if(!gps_search_baud_rate()) {
+        //without an answer SERCOM3 goes back to the factory setting
+        gps_set_baud_rate(gps_baud_rates[0]);
+        return false;
+    }
+
+    if(gps_baud_rate != GPS_BAUD_RATE) {
+        //UBX-CFG-PRT for UART1 with 8N1, ubx and nmea in and output
+        const uint8_t port[20] = {
+            0x01, 0x00, 0x00, 0x00,
+            0xD0, 0x08, 0x00, 0x00,
+            (uint8_t)GPS_BAUD_RATE, (uint8_t)(GPS_BAUD_RATE >> 8),
+            (uint8_t)(GPS_BAUD_RATE >> 16), (uint8_t)(GPS_BAUD_RATE >> 24),
+            0x03, 0x00, 0x03, 0x00,
+            0x00, 0x00, 0x00, 0x00,
+        };
+        gps_send_ubx(0x06, 0x00, port, sizeof(port));
+        gps_wait_transmit();
+        gps_set_baud_rate(GPS_BAUD_RATE);
+
+        //when the modul did not change the baud rate it has to be searched
+        //again, it is then used with the baud rate where it answers
+        if(!gps_wait_for_sentence(1500) && !gps_search_baud_rate()) {
+            return false;
+        }
+    }
+
+    //UBX-CFG-MSG for every message on the current port
+    for(uint8_t i = 0; i < sizeof(gps_message_rates) / sizeof(gps_message_rates[0]); i++) {
+        gps_send_ubx(0x06, 0x01, gps_message_rates[i],
+                sizeof(gps_message_rates[i]));
+    }
+
+    //UBX-CFG-RATE with the measurement period, one navigation solution per
+    //measurement and the gps time as reference
+    const uint8_t rate[6] = {
+        (uint8_t)GPS_UPDATE_PERIOD_MS, (uint8_t)(GPS_UPDATE_PERIOD_MS >> 8),
+        0x01, 0x00, 0x01, 0x00,
+    };
+    gps_send_ubx(0x06, 0x08, rate, sizeof(rate));
+    gps_wait_transmit();
+
+    return true;
+}
+
+//this function returns the current baud rate of SERCOM3
+uint32_t gps_get_baud_rate(void) {
+    return gps_baud_rate;
+}
+
+//this function returns the measured rate of the GGA sentences in 1/100 Hz
+uint16_t gps_get_fix_rate(void) {
+    return gps_fix_rate;
+}
+
+//this function returns the system time in ms of the first fix and of the
+//first fix with GPS_GOOD_SATELLITES after the start, 0 means not yet
+void gps_get_start_times(uint32_t* first_fix_ms, uint32_t* good_satellites_ms) {
+    *first_fix_ms = gps_first_fix_ms;
+    *good_satellites_ms = gps_good_satellites_ms;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function starts the continous receiving at SERCOM3, after this every
+//incoming byte will be handled in the receive interrupt
+void gps_initialize(void) {
+    gps_write_index = 0;
+    gps_read_index = 0;
+    gps_line_length = 0;
+    gps_line_active = false;
+    gps_lost_sentences = 0;
+    gps_line_dropped = false;
+    gps_dropped_bytes = 0;
+    memset(&gps_fix, 0, sizeof(gps_fix));
+    memset(&gps_satellites, 0, sizeof(gps_satellites));
+    memset(gps_gsv_next_message, 0, sizeof(gps_gsv_next_message));
+
+    SERCOM3_USART_ReadCallbackRegister(gps_receive_callback, 0);
+    SERCOM3_USART_Read(&gps_receive_byte, 1);
+}
+
+//this function returns the oldest complete sentence without the line ending
+//or NULL when there is no sentence. It does not block and the sentence stays
+//valid until gps_release_sentence is called. Nmea sentences start with '$',
+//in the UBX protocol all other entries are NAV-PVT frames starting with the
+//class, id and length without the checked sync characters and checksum
+const char* gps_peek_sentence(void) {
+    if(gps_read_index == gps_write_index) {
+        return NULL;
+    }
+    return gps_lines[gps_read_index & (GPS_LINE_COUNT - 1)];
+}
+
+//this function gives the oldest sentence back to the receive interrupt
+void gps_release_sentence(void) {
+    if(gps_read_index != gps_write_index) {
+        gps_read_index++;
+    }
+}
+
+//this function returns the receive time of the sentence of gps_peek_sentence
+//in microseconds, it is taken in the interrupt at the start of the sentence
+//and at its end
+void gps_get_sentence_time(uint32_t* start_us, uint32_t* end_us) {
+    uint8_t slot = gps_read_index & (GPS_LINE_COUNT - 1);
+    *start_us = gps_line_start_us[slot];
+    *end_us = gps_line_end_us[slot];
+}
+
+//this function publishes a new fix, the sequence number and the timestamp
+//are set here. The utc time only moves the clock when utc_valid is true
+static void gps_publish_fix(gps_fix_t* fix, bool utc_valid) {
+    uint8_t slot = gps_read_index & (GPS_LINE_COUNT - 1);
+
+    //the fix is always published from the oldest sentence in the pool
+    fix->receive_start_us = gps_line_start_us[slot];
+    fix->receive_end_us = gps_line_end_us[slot];
+    fix->timestamp = systime_get_ms();
+
+    //the utc time of a full second connects the system time with the PPS
+    if(utc_valid) {
+        systime_set_utc(fix->time_ms, fix->receive_start_us);
+    }
+
+    //the time to the first fix and to enough satellites after the start
+    if(gps_first_fix_ms == 0) {
+        gps_first_fix_ms = fix->timestamp;
+    }
+    if(gps_good_satellites_ms == 0 && fix->satellites >= GPS_GOOD_SATELLITES) {
+        gps_good_satellites_ms = fix->timestamp;
+    }
+    fix->sequence = gps_fix.sequence + 1;
+    gps_fix = *fix;
+}
+
+//this function publishes a decoded GGA sentence as new fix
+static void gps_publish_gga(const nmea_gga_t* gga) {
+    gps_fix_t fix = {0};
+
+    //only sentences with a valid position will be published
+    if(gga->quality == 0) {
+        return;
+    }
+
+    fix.time_ms = gga->time_ms;
+    fix.latitude = gga->latitude;
+    fix.longitude = gga->longitude;
+    fix.altitude = gga->altitude * 10;
+    fix.quality = gga->quality;
+    fix.satellites = gga->satellites;
+    fix.hdop = gga->hdop;
+    fix.date = gps_date;
+
+    //the velocity of the VTG sentence is only used once
+    if(gps_vtg.valid && gps_vtg.course >= 0) {
+        fix.ground_speed = gps_vtg.speed;
+        fix.course = gps_vtg.course;
+    }
+    gps_vtg.valid = false;
+    gps_publish_fix(&fix, true);
+}
+
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+//this function reads a little endian number byte by byte, the Cortex-M0+
+//can not read unaligned words
+static uint32_t gps_read_u32(const uint8_t* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8)
+            | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+//this function publishes a NAV-PVT frame as new fix, the payload starts
+//after the class, id and length
+static void gps_publish_nav_pvt(const uint8_t* frame) {
+    const uint8_t* payload = frame + GPS_UBX_HEADER_LENGTH;
+    gps_fix_t fix = {0};
+
+    //only a 2D or 3D fix with the gnssFixOK flag will be published
+    uint8_t fix_type = payload[20];
+    uint8_t flags = payload[21];
+    if(!(flags & 0x01) || fix_type < 2 || fix_type > 4) {
+        return;
+    }
+
+    //utc time of the day, the nanoseconds can be negative
+    int32_t time_ms = (payload[8] * 3600L + payload[9] * 60L + payload[10])
+            * 1000L + (int32_t)gps_read_u32(&payload[16]) / 1000000L;
+    fix.time_ms = time_ms < 0 ? 0 : (uint32_t)time_ms;
+
+    fix.longitude = (int32_t)gps_read_u32(&payload[24]);
+    fix.latitude = (int32_t)gps_read_u32(&payload[28]);
+    fix.altitude = (int32_t)gps_read_u32(&payload[36]);
+    fix.horizontal_accuracy = gps_read_u32(&payload[40]);
+    fix.vertical_accuracy = gps_read_u32(&payload[44]);
+    fix.velocity_north = (int32_t)gps_read_u32(&payload[48]);
+    fix.velocity_east = (int32_t)gps_read_u32(&payload[52]);
+    fix.velocity_down = (int32_t)gps_read_u32(&payload[56]);
+    fix.ground_speed = gps_read_u32(&payload[60]);
+    fix.speed_accuracy = gps_read_u32(&payload[68]);
+
+    //the heading is in 1e-5 degrees
+    fix.course = (int32_t)gps_read_u32(&payload[64]) / 1000;
+    fix.course_accuracy = gps_read_u32(&payload[72]) / 1000;
+
+    //quality like GGA, 2 for a differential solution
+    fix.quality = (flags & 0x02) ? 2 : 1;
+    fix.satellites = payload[23];
+    fix.hdop = (uint16_t)(payload[76] | (payload[77] << 8));
+
+    //date as ddmmyy when the validDate flag is set
+    if(payload[11] & 0x01) {
+        uint16_t year = (uint16_t)(payload[4] | (payload[5] << 8));
+        fix.date = payload[7] * 10000UL + payload[6] * 100UL + year % 100;
+    }
+
+    //the time is only taken for the clock when the validTime and the
+    //fullyResolved flags are set, before this it can be off by seconds
+    gps_publish_fix(&fix, (payload[11] & 0x06) == 0x06);
+}
+#endif
+
+//this function counts the GGA sentences and calculates their rate every
+//two seconds
+static void gps_measure_fix_rate(void) {
+    uint32_t now = systime_get_ms();
+    uint32_t elapsed = now - gps_rate_window_start;
+
+    gps_rate_window_count++;
+    if(elapsed >= 2000) {
+        gps_fix_rate = (uint16_t)((gps_rate_window_count * 100000UL) / elapsed);
+        gps_rate_window_start = now;
+        gps_rate_window_count = 0;
+    }
+}
+
+//this function returns the constellation of a talker
+static uint8_t gps_constellation(const char* talker) {
+    for(uint8_t i = 0; i < GPS_CONSTELLATION_OTHER; i++) {
+        if(talker[0] == gps_constellation_talker[i][0]
+                && talker[1] == gps_constellation_talker[i][1]) {
+            return i;
+        }
+    }
+    return GPS_CONSTELLATION_OTHER;
+}
+
+//this function removes all satellites of a constellation which were not in
+//the current group, they are not in view anymore
+static void gps_remove_old_satellites(uint8_t constellation) {
+    uint8_t count = 0;
+
+    for(uint8_t i = 0; i < gps_satellites.count; i++) {
+        const gps_satellite_t* satellite = &gps_satellites.satellite[i];
+        if(satellite->constellation == constellation
+                && satellite->group != gps_gsv_group[constellation]) {
+            continue;
+        }
+        gps_satellites.satellite[count++] = *satellite;
+    }
+    gps_satellites.count = count;
+}
+
+//this function updates the satellite table with one part of a GSV group.
+//When a part is missing the rest of the group is ignored, after the last
+//part the satellites which are not in view anymore are removed
+static void gps_update_satellites(const nmea_gsv_t* gsv) {
+    uint8_t constellation = gps_constellation(gsv->talker);
+
+    if(gsv->message_number == 1) {
+        gps_gsv_group[constellation]++;
+        gps_gsv_next_message[constellation] = 1;
+    }
+    if(gsv->message_number != gps_gsv_next_message[constellation]) {
+        gps_gsv_next_message[constellation] = 0;
+        return;
+    }
+    gps_gsv_next_message[constellation]++;
+
+    for(uint8_t i = 0; i < gsv->satellite_count; i++) {
+        const nmea_gsv_satellite_t* data = &gsv->satellite[i];
+        gps_satellite_t* satellite = NULL;
+
+        for(uint8_t j = 0; j < gps_satellites.count; j++) {
+            if(gps_satellites.satellite[j].constellation == constellation
+                    && gps_satellites.satellite[j].prn == data->prn) {
+                satellite = &gps_satellites.satellite[j];
+                break;
+            }
+        }
+
+        if(satellite == NULL) {
+            //when the table is full the satellite will be ignored
+            if(gps_satellites.count >= GPS_SATELLITE_COUNT) {
+                continue;
+            }
+            satellite = &gps_satellites.satellite[gps_satellites.count++];
+            satellite->constellation = constellation;
+            satellite->prn = data->prn;
+        }
+
+        satellite->group = gps_gsv_group[constellation];
+        satellite->elevation = data->elevation;
+        satellite->azimuth = data->azimuth;
+        satellite->signal_strength = data->signal_strength;
+    }
+
+    if(gsv->message_number == gsv->message_count) {
+        gps_remove_old_satellites(constellation);
+        gps_gsv_next_message[constellation] = 0;
+        gps_satellites.receive_end_us =
+                gps_line_end_us[gps_read_index & (GPS_LINE_COUNT - 1)];
+        gps_satellites.epoch++;
+    }
+}
+
+//this function decodes all finished sentences, publishes a new fix for
+//every valid GGA sentence or NAV-PVT frame and updates the satellite table
+//with the GSV sentences. It does not block and has to be called regularly
+void gps_update(void) {
+    const char* line;
+    nmea_sentence_t sentence;
+    nmea_gga_t gga;
+    nmea_gsv_t gsv;
+    nmea_rmc_t rmc;
+    nmea_vtg_t vtg;
+
+    while((line = gps_peek_sentence()) != NULL) {
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+        //all entries which are not nmea are checked NAV-PVT frames
+        if(line[0] != '$') {
+            gps_measure_fix_rate();
+            gps_publish_nav_pvt((const uint8_t*)line);
+            gps_release_sentence();
+            continue;
+        }
+#endif
+        //sentences with a wrong checksum will be thrown away
+        if(nmea_tokenize(line, &sentence)) {
+            if(nmea_parse_gga(&sentence, &gga)) {
+                gps_measure_fix_rate();
+                gps_publish_gga(&gga);
+            } else if(nmea_parse_gsv(&sentence, &gsv)) {
+                gps_update_satellites(&gsv);
+            } else if(nmea_parse_vtg(&sentence, &vtg)) {
+                gps_vtg = vtg;
+            } else if(nmea_parse_rmc(&sentence, &rmc) && rmc.date != 0) {
+                gps_date = rmc.date;
+            }
+        }
+        gps_release_sentence();
+    }
+}
+
+//this function returns the last published fix, it is always the same
+//snapshot until the next valid position has been decoded
+const gps_fix_t* gps_get_fix(void) {
+    return &gps_fix;
+}
+
+//this function returns true when there is a newer fix than the one with the
+//sequence number and sets the sequence number to the newest one
+bool gps_has_new_fix(uint32_t* sequence) {
+    if(*sequence == gps_fix.sequence) {
+        return false;
+    }
+    *sequence = gps_fix.sequence;
+    return true;
+}
+
+//this function returns the table of the satellites in view, it is only
+//complete when the epoch has changed
+const gps_satellite_table_t* gps_get_satellites(void) {
+    return &gps_satellites;
+}
+
+//this function returns true when a GSV group has been completed since the
+//epoch and sets the epoch to the newest one
+bool gps_has_new_satellite_epoch(uint32_t* epoch) {
+    if(*epoch == gps_satellites.epoch) {
+        return false;
+    }
+    *epoch = gps_satellites.epoch;
+    return true;
+}
+
+//this function returns the list of the receive filter with its counters
+//and writes the amount of entries into count
+const gps_sentence_filter_t* gps_get_sentence_filter(uint8_t* count) {
+    *count = GPS_FILTER_COUNT;
+    return gps_sentence_filter;
+}
+
+//this function returns the amount of bytes which were thrown away by the
+//receive filter without being buffered
+uint32_t gps_get_dropped_bytes(void) {
+    return gps_dropped_bytes;
+}
+
+//this function returns the amount of sentences which were lost because
+//the pool was full, a line was too long or the uart had an error
+uint32_t gps_get_lost_sentences(void) {
+    return gps_lost_sentences;
+}
+
+/* *****************************************************************************
+ End of File
+ */
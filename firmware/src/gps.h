@@ -0,0 +1,204 @@
+/* ************************************************************************** */
+/** gps
+
+  @Company
+    Schindelar
+
+  @File Name
+    gps.h
+
+  @Summary
+    Interrupt driven receive path for the gps modul at SERCOM3
+ */
+/* ************************************************************************** */
+
+#ifndef _GPS_H    /* Guard against multiple inclusion */
+#define _GPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//amount of line buffers in the pool, has to be a power of two because the
+//read and write index are running free and will be masked
+#define GPS_LINE_COUNT 4
+
+//a nmea sentence has a maximum of 82 characters, the rest is a safety margin
+//a NAV-PVT frame without the sync characters and the checksum fits exactly
+#define GPS_LINE_LENGTH 96
+
+//protocols for the position of the gps modul
+#define GPS_PROTOCOL_NMEA 0     //GGA text sentences
+#define GPS_PROTOCOL_UBX 1      //binary UBX-NAV-PVT frames
+
+//the protocol is selected at build time, e.g. with -DGPS_PROTOCOL=1
+//the satellite sentences (GSV) are always received as nmea text
+#ifndef GPS_PROTOCOL
+#define GPS_PROTOCOL GPS_PROTOCOL_NMEA
+#endif
+
+//baud rate of SERCOM3 after the configuration of the gps modul
+#define GPS_BAUD_RATE 115200
+
+//time between two position updates of the gps modul in milliseconds
+//100ms are 10 Hz
+#define GPS_UPDATE_PERIOD_MS 100
+
+//the satellite sentences (GSV) are only sent at every n-th update
+#define GPS_SATELLITE_DIVIDER 5
+
+//the RMC sentence is only required for the date, it is sent every second
+#define GPS_DATE_DIVIDER (1000 / GPS_UPDATE_PERIOD_MS)
+
+//amount of satellites from which the position is exact enough
+#define GPS_GOOD_SATELLITES 8
+
+//maximum payload of a ubx message which can be sent to the modul
+#define GPS_UBX_MAX_PAYLOAD 40
+
+//maximum amount of satellites in view of all constellations together
+#define GPS_SATELLITE_COUNT 32
+
+//constellations of the satellites, they are known by the talker of the GSV
+//sentence
+#define GPS_CONSTELLATION_GPS 0     //GP
+#define GPS_CONSTELLATION_GLONASS 1 //GL
+#define GPS_CONSTELLATION_GALILEO 2 //GA
+#define GPS_CONSTELLATION_BEIDOU 3  //GB
+#define GPS_CONSTELLATION_OTHER 4   //all other talkers
+#define GPS_CONSTELLATION_COUNT 5
+
+//statistic of one sentence type of the receive filter, the last entry is
+//for all sentence types which are not in the list
+typedef struct {
+    char type[4];           //sentence type without the talker, e.g. "GGA"
+    bool accepted;          //true when the sentence will be buffered
+    uint32_t accepted_count;    //amount of buffered sentences
+    uint32_t dropped_count;     //amount of dropped sentences
+} gps_sentence_filter_t;
+
+//snapshot of the last valid position of the gps modul, it will be published
+//once for every valid GGA sentence or NAV-PVT frame. The velocity and the
+//accuracy are only delivered by NAV-PVT, with GGA they are 0 except the
+//ground speed and the course of the VTG sentence before it
+typedef struct {
+    uint32_t sequence;      //increases with every new fix, 0 means no fix yet
+    uint32_t timestamp;     //system time in ms when the fix has arrived
+    uint32_t receive_start_us;  //systime_get_us at the start of the sentence
+    uint32_t receive_end_us;    //systime_get_us at the end of the sentence
+    uint32_t time_ms;       //utc time of the day in milliseconds
+    uint32_t date;          //utc date as ddmmyy, 0 when it is not known yet
+    int32_t latitude;       //latitude in 1e-7 degrees, south is negative
+    int32_t longitude;      //longitude in 1e-7 degrees, west is negative
+    int32_t altitude;       //altitude above sea level in millimetres
+    uint8_t quality;        //fix quality like in the GGA sentence
+    uint8_t satellites;     //amount of used satellites
+    uint16_t hdop;          //horizontal dilution of precision in 1/100,
+                            //NAV-PVT only has the position dop
+    int32_t velocity_north; //velocity to the north in mm/s
+    int32_t velocity_east;  //velocity to the east in mm/s
+    int32_t velocity_down;  //velocity downwards in mm/s
+    uint32_t ground_speed;  //speed over ground in mm/s
+    int32_t course;         //course over ground in 1/100 degrees
+    uint32_t horizontal_accuracy;   //estimated position accuracy in mm
+    uint32_t vertical_accuracy;     //estimated altitude accuracy in mm
+    uint32_t speed_accuracy;        //estimated speed accuracy in mm/s
+    uint32_t course_accuracy;       //estimated course accuracy in 1/100 deg
+} gps_fix_t;
+
+//one satellite in view of the gps modul
+typedef struct {
+    uint8_t constellation;  //GPS_CONSTELLATION_...
+    uint8_t group;          //number of the GSV group which has seen it last
+    uint16_t prn;           //number of the satellite in its constellation
+    int8_t elevation;       //elevation in degrees
+    int8_t signal_strength; //signal strength in dB, -1 when it is not tracked
+    uint16_t azimuth;       //azimuth in degrees
+} gps_satellite_t;
+
+//all satellites in view, the table is updated with every GSV sentence and
+//the epoch increases when the last sentence of a GSV group has arrived
+typedef struct {
+    uint32_t epoch;         //0 means there was no complete group yet
+    uint32_t receive_end_us;    //systime_get_us at the end of the last group
+    uint8_t count;          //amount of satellites in the table
+    gps_satellite_t satellite[GPS_SATELLITE_COUNT];
+} gps_satellite_table_t;
+
+//this function starts the continous receiving at SERCOM3, after this every
+//incoming byte will be handled in the receive interrupt
+void gps_initialize(void);
+
+//this function configures the gps modul after the start. It searches the
+//baud rate of the modul, sets the sentence mask, the update rate and
+//switches the modul and SERCOM3 to GPS_BAUD_RATE.
+//returns false when the modul does not answer at any baud rate
+bool gps_configure(void);
+
+//this function returns the current baud rate of SERCOM3
+uint32_t gps_get_baud_rate(void);
+
+//this function returns the measured rate of the GGA sentences in 1/100 Hz
+uint16_t gps_get_fix_rate(void);
+
+//this function returns the system time in ms of the first fix and of the
+//first fix with GPS_GOOD_SATELLITES after the start, 0 means not yet
+void gps_get_start_times(uint32_t* first_fix_ms, uint32_t* good_satellites_ms);
+
+//this function sends a ubx message with its fletcher checksum to the modul
+//the payload can have up to GPS_UBX_MAX_PAYLOAD bytes
+void gps_send_ubx(uint8_t message_class, uint8_t message_id,
+        const uint8_t* payload, uint16_t length);
+
+//this function returns the oldest complete sentence without the line ending
+//or NULL when there is no sentence. It does not block and the sentence stays
+//valid until gps_release_sentence is called. Nmea sentences start with '$',
+//in the UBX protocol all other entries are NAV-PVT frames starting with the
+//class, id and length without the checked sync characters and checksum
+const char* gps_peek_sentence(void);
+
+//this function gives the oldest sentence back to the receive interrupt
+void gps_release_sentence(void);
+
+//this function returns the receive time of the sentence of gps_peek_sentence
+//in microseconds, it is taken in the interrupt at the start of the sentence
+//and at its end
+void gps_get_sentence_time(uint32_t* start_us, uint32_t* end_us);
+
+//this function decodes all finished sentences, publishes a new fix for
+//every valid GGA sentence or NAV-PVT frame and updates the satellite table
+//with the GSV sentences. It does not block and has to be called regularly
+void gps_update(void);
+
+//this function returns the last published fix, it is always the same
+//snapshot until the next valid position has been decoded
+const gps_fix_t* gps_get_fix(void);
+
+//this function returns true when there is a newer fix than the one with the
+//sequence number and sets the sequence number to the newest one
+bool gps_has_new_fix(uint32_t* sequence);
+
+//this function returns the table of the satellites in view, it is only
+//complete when the epoch has changed
+const gps_satellite_table_t* gps_get_satellites(void);
+
+//this function returns true when a GSV group has been completed since the
+//epoch and sets the epoch to the newest one
+bool gps_has_new_satellite_epoch(uint32_t* epoch);
+
+//this function returns the list of the receive filter with its counters
+//and writes the amount of entries into count
+const gps_sentence_filter_t* gps_get_sentence_filter(uint8_t* count);
+
+//this function returns the amount of bytes which were thrown away by the
+//receive filter without being buffered
+uint32_t gps_get_dropped_bytes(void);
+
+//this function returns the amount of sentences which were lost because
+//the pool was full, a line was too long or the uart had an error
+uint32_t gps_get_lost_sentences(void);
+
+#endif /* _GPS_H */
+
+/* *****************************************************************************
+ End of File
+ */
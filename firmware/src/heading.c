@@ -0,0 +1,235 @@
+/* ************************************************************************** */
+/** heading
+
+  @Company
+    Schindelar
+
+  @File Name
+    heading.c
+
+  @Summary
+    Heading of the drone for the alignment to the leg. The azimuths of the
+    satellites only show the geometry of the sky, so the course over ground
+    is the better heading as soon as the drone flies forward. The course
+    comes from the velocity of the fix (VTG or NAV-PVT) and without it from
+    two positions of the fixes. The rate of the headings and the time until
+    they have converged are measured from the last reset.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "heading.h"
+#include "geo.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//selected source of the heading
+static uint8_t heading_source = HEADING_SOURCE_SATELLITES;
+
+//newest heading in 1/100 degrees and the system time in ms when it was set,
+//the time is 0 when there is no heading since the reset
+static uint16_t heading_value = 0;
+static uint32_t heading_time_ms = 0;
+
+//measurement of the rate and of the convergence since the reset
+static uint32_t heading_reset_ms = 0;
+static uint32_t heading_count = 0;
+static uint8_t heading_stable_count = 0;
+static uint32_t heading_convergence_ms = 0;
+
+//position of the fix from which the course is calculated when the fix has
+//no velocity, in 1e-7 degrees with the cos scale of its latitude
+static bool heading_anchor_valid = false;
+static int32_t heading_anchor_latitude = 0;
+static int32_t heading_anchor_longitude = 0;
+static uint16_t heading_anchor_scale = 0;
+static uint32_t heading_anchor_us = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function calculates the difference between two headings in 1/100
+//degrees, the shorter way around
+static uint16_t heading_difference(uint16_t first, uint16_t second) {
+    uint16_t difference = (first > second) ? first - second : second - first;
+
+    return (difference > 18000) ? 36000 - difference : difference;
+}
+
+//this function sets a new heading and counts it for the rate and the
+//convergence
+static void heading_publish(uint16_t heading, uint32_t time_ms) {
+    if(heading_time_ms != 0 && heading_convergence_ms == 0) {
+        if(heading_difference(heading, heading_value)
+                < HEADING_CONVERGED_TOLERANCE) {
+            heading_stable_count++;
+        } else {
+            heading_stable_count = 0;
+        }
+
+        //the first heading has no predecessor, so it counts as one
+        if(heading_stable_count + 1 >= HEADING_CONVERGED_COUNT) {
+            heading_convergence_ms = time_ms - heading_reset_ms;
+            if(heading_convergence_ms == 0) {
+                heading_convergence_ms = 1;
+            }
+        }
+    }
+
+    heading_value = heading;
+    heading_time_ms = time_ms;
+    heading_count++;
+}
+
+//this function sets the position from which the course is calculated
+static void heading_set_anchor(const gps_fix_t* fix) {
+    heading_anchor_latitude = fix->latitude;
+    heading_anchor_longitude = fix->longitude;
+    heading_anchor_scale = geo_cos_scale(fix->latitude);
+    heading_anchor_us = fix->receive_end_us;
+    heading_anchor_valid = true;
+}
+
+//this function calculates the course from the anchor to the fix, the anchor
+//is only moved when the drone is far enough away from it, so the noise of
+//the positions does not turn the course
+static bool heading_course_from_positions(const gps_fix_t* fix,
+        uint16_t* course) {
+    if(!heading_anchor_valid) {
+        heading_set_anchor(fix);
+        return false;
+    }
+
+    int32_t north = geo_north(fix->latitude - heading_anchor_latitude);
+    int32_t east = geo_east(fix->longitude - heading_anchor_longitude,
+            heading_anchor_scale);
+    uint32_t distance = geo_isqrt((uint64_t)((int64_t)north * north)
+            + (uint64_t)((int64_t)east * east));
+    uint32_t delta_us = fix->receive_end_us - heading_anchor_us;
+
+    //after a long gap the anchor is too old for a speed
+    if(delta_us > HEADING_MAX_ANCHOR_MS * 1000) {
+        heading_set_anchor(fix);
+        return false;
+    }
+    if(distance < HEADING_MIN_DISTANCE || delta_us == 0) {
+        return false;
+    }
+
+    //the distance is in centimetres and the speed in mm/s
+    uint32_t speed = (uint32_t)(((uint64_t)distance * 10000000ULL) / delta_us);
+    heading_set_anchor(fix);
+    if(speed < HEADING_MIN_SPEED) {
+        return false;
+    }
+
+    *course = geo_atan2(east, north);
+    return true;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function selects the source of the heading and resets the heading
+void heading_set_source(uint8_t source) {
+    heading_source = source;
+    heading_reset();
+}
+
+//this function returns the selected source of the heading
+uint8_t heading_get_source(void) {
+    return heading_source;
+}
+
+//this function throws the heading away and starts the measurement of the
+//update rate and of the convergence time again
+void heading_reset(void) {
+    heading_value = 0;
+    heading_time_ms = 0;
+    heading_reset_ms = systime_get_ms();
+    heading_count = 0;
+    heading_stable_count = 0;
+    heading_convergence_ms = 0;
+    heading_anchor_valid = false;
+}
+
+//this function calculates the course over ground of the fix, it is the
+//heading when the drone flies forward. Returns true when the course source
+//is selected and the fix gave a new heading
+bool heading_update_course(const gps_fix_t* fix) {
+    uint16_t course;
+
+    if(heading_source != HEADING_SOURCE_COURSE || fix->sequence == 0) {
+        return false;
+    }
+
+    if(fix->ground_speed != 0) {
+        //the velocity of the fix, NAV-PVT also tells how exact the course is
+        if(fix->ground_speed < HEADING_MIN_SPEED || (fix->course_accuracy != 0
+                && fix->course_accuracy > HEADING_MAX_COURSE_ACCURACY)) {
+            return false;
+        }
+        course = (uint16_t)(fix->course % 36000);
+    } else if(!heading_course_from_positions(fix, &course)) {
+        return false;
+    }
+
+    heading_publish(course, fix->timestamp);
+    return true;
+}
+
+//this function sets the heading from the azimuths of the satellites in
+//1/100 degrees, it is only used when the satellite source is selected
+void heading_update_satellites(uint16_t heading) {
+    if(heading_source != HEADING_SOURCE_SATELLITES) {
+        return;
+    }
+    heading_publish(heading % 36000, systime_get_ms());
+}
+
+//this function returns the newest heading in 1/100 degrees, north is 0 and
+//east is 9000. Returns false when there is no heading or it is too old
+bool heading_get(uint16_t* heading) {
+    if(heading_time_ms == 0
+            || (systime_get_ms() - heading_time_ms) > HEADING_MAX_AGE_MS) {
+        return false;
+    }
+    *heading = heading_value;
+    return true;
+}
+
+//this function returns the rate of the headings since the reset in 1/100 Hz
+uint16_t heading_get_rate(void) {
+    uint32_t elapsed = systime_get_ms() - heading_reset_ms;
+
+    if(elapsed == 0) {
+        return 0;
+    }
+    return (uint16_t)((heading_count * 100000UL) / elapsed);
+}
+
+//this function returns the time in milliseconds from the reset until the
+//heading has converged, 0 when it has not converged yet
+uint32_t heading_get_convergence_ms(void) {
+    return heading_convergence_ms;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/** heading
+
+  @Company
+    Schindelar
+
+  @File Name
+    heading.h
+
+  @Summary
+    Heading of the drone from the course over ground or from the azimuths
+    of the satellites, the source can be changed at runtime
+ */
+/* ************************************************************************** */
+
+#ifndef _HEADING_H    /* Guard against multiple inclusion */
+#define _HEADING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps.h"
+
+//sources of the heading
+#define HEADING_SOURCE_SATELLITES 0 //weighted azimuths of the satellites
+#define HEADING_SOURCE_COURSE 1     //course over ground of the fixes
+
+//below this ground speed in mm/s the course over ground does not show the
+//direction of the drone anymore
+#define HEADING_MIN_SPEED 500UL
+
+//a course of NAV-PVT with a worse accuracy in 1/100 degrees is not used
+#define HEADING_MAX_COURSE_ACCURACY 2000UL
+
+//without a velocity in the fix the course comes from two positions, they
+//have to be at least this far apart in centimetres
+#define HEADING_MIN_DISTANCE 100
+
+//the position from which the course is calculated is replaced when it is
+//older than this in milliseconds, it is the time for the minimum distance
+//at the minimum speed
+#define HEADING_MAX_ANCHOR_MS (HEADING_MIN_DISTANCE * 10000UL / HEADING_MIN_SPEED)
+
+//a heading which is older than this in milliseconds is not valid anymore
+#define HEADING_MAX_AGE_MS 1000UL
+
+//the heading has converged when this amount of headings one after the other
+//differ by less than the tolerance in 1/100 degrees
+#define HEADING_CONVERGED_COUNT 3
+#define HEADING_CONVERGED_TOLERANCE 500
+
+//this function selects the source of the heading and resets the heading
+void heading_set_source(uint8_t source);
+
+//this function returns the selected source of the heading
+uint8_t heading_get_source(void);
+
+//this function throws the heading away and starts the measurement of the
+//update rate and of the convergence time again
+void heading_reset(void);
+
+//this function calculates the course over ground of the fix, it is the
+//heading when the drone flies forward. Returns true when the course source
+//is selected and the fix gave a new heading
+bool heading_update_course(const gps_fix_t* fix);
+
+//this function sets the heading from the azimuths of the satellites in
+//1/100 degrees, it is only used when the satellite source is selected
+void heading_update_satellites(uint16_t heading);
+
+//this function returns the newest heading in 1/100 degrees, north is 0 and
+//east is 9000. Returns false when there is no heading or it is too old
+bool heading_get(uint16_t* heading);
+
+//this function returns the rate of the headings since the reset in 1/100 Hz
+uint16_t heading_get_rate(void);
+
+//this function returns the time in milliseconds from the reset until the
+//heading has converged, 0 when it has not converged yet
+uint32_t heading_get_convergence_ms(void);
+
+#endif /* _HEADING_H */
+
+/* *****************************************************************************
+ End of File
+ */
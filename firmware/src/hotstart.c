@@ -0,0 +1,301 @@
+/* ************************************************************************** */
+/** hotstart
+
+  @Company
+    Schindelar
+
+  @File Name
+    hotstart.c
+
+  @Summary
+    Last good fix of the gps modul in the data flash. Every record fills one
+    page and the records are written one after the other over all pages, a
+    row is only erased when the next record starts in it. The record is
+    written in steps by the flash task, so no other task waits for the
+    NVMCTRL. At the start the record with the highest sequence is read and
+    its position is sent to the modul with UBX-MGA-INI-POS_LLH.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <string.h>
+#include "definitions.h"
+#include "hotstart.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//marker of a written record, "HOT1"
+#define HOTSTART_MAGIC 0x31544F48UL
+
+//amount of pages and pages in one row of the data flash
+#define HOTSTART_PAGES (DATAFLASH_SIZE / NVMCTRL_DATAFLASH_PAGESIZE)
+#define HOTSTART_PAGES_PER_ROW \
+    (NVMCTRL_DATAFLASH_ROWSIZE / NVMCTRL_DATAFLASH_PAGESIZE)
+
+//amount of words of a record without the checksum
+#define HOTSTART_WORDS (sizeof(hotstart_record_t) / sizeof(uint32_t) - 1)
+
+//steps of the write of a record, the NVMCTRL runs the erase of the row
+//and the write of the page while the other tasks go on
+#define HOTSTART_IDLE 0         //no record is written at the moment
+#define HOTSTART_ERASING 1      //the row of the next page is erased
+#define HOTSTART_WRITING 2      //the record is written into the page
+
+//a record has to fill exactly one page, otherwise the array size is -1
+typedef char hotstart_record_size_check[
+        (sizeof(hotstart_record_t) == NVMCTRL_DATAFLASH_PAGESIZE) ? 1 : -1];
+
+//the record which was read at the start
+static hotstart_record_t hotstart_record;
+static bool hotstart_valid = false;
+
+//page and sequence of the newest record in the data flash, the next record
+//will be written into the page after it
+static uint8_t hotstart_page = HOTSTART_PAGES - 1;
+static uint32_t hotstart_sequence = 0;
+
+//the record which waits for the flash task and if there is one, a newer
+//record replaces it until the write of it has started
+static hotstart_record_t hotstart_queued;
+static bool hotstart_queued_valid = false;
+
+//the record which is written at the moment, its page and the step
+static hotstart_record_t hotstart_written;
+static uint8_t hotstart_written_page = 0;
+static uint8_t hotstart_step = HOTSTART_IDLE;
+
+//days before the first day of the month in a year which is no leap year
+static const uint16_t hotstart_month_days[12] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334,
+};
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns the address of a page in the data flash
+static uint32_t hotstart_address(uint8_t page) {
+    return NVMCTRL_DATAFLASH_START_ADDRESS
+            + (uint32_t)page * NVMCTRL_DATAFLASH_PAGESIZE;
+}
+
+//this function calculates the checksum of a record
+static uint32_t hotstart_checksum(const hotstart_record_t* record) {
+    const uint32_t* word = (const uint32_t*)record;
+    uint32_t sum = 0;
+
+    for(uint8_t i = 0; i < HOTSTART_WORDS; i++) {
+        sum += word[i];
+    }
+    return ~sum;
+}
+
+//this function returns true when all bytes of the page are erased
+static bool hotstart_page_erased(uint8_t page) {
+    const uint32_t* word = (const uint32_t*)hotstart_address(page);
+
+    for(uint8_t i = 0; i < NVMCTRL_DATAFLASH_PAGESIZE / 4; i++) {
+        if(word[i] != 0xFFFFFFFFUL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//this function changes the utc date ddmmyy and the time of the day into
+//seconds since the 1.1.2000, the date has to be between 2000 and 2099
+static uint32_t hotstart_seconds(uint32_t date, uint32_t time_ms) {
+    uint32_t day = date / 10000;
+    uint32_t month = (date / 100) % 100;
+    uint32_t year = date % 100;
+
+    if(month < 1 || month > 12 || day < 1) {
+        return 0;
+    }
+
+    //every fourth year is a leap year, 2000 is one too
+    uint32_t days = year * 365 + (year + 3) / 4
+            + hotstart_month_days[month - 1] + day - 1;
+    if((year % 4) == 0 && month > 2) {
+        days++;
+    }
+
+    return days * 86400UL + time_ms / 1000;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function reads the newest record from the data flash and sends the
+//position to the gps modul as aiding data.
+//returns false when there is no valid record
+bool hotstart_restore(void) {
+    hotstart_record_t record;
+
+    hotstart_valid = false;
+    hotstart_page = HOTSTART_PAGES - 1;
+    hotstart_sequence = 0;
+
+    for(uint8_t page = 0; page < HOTSTART_PAGES; page++) {
+        NVMCTRL_DATA_FLASH_Read((uint32_t*)&record, sizeof(record),
+                hotstart_address(page));
+        if(record.magic != HOTSTART_MAGIC
+                || record.checksum != hotstart_checksum(&record)) {
+            continue;
+        }
+        if(!hotstart_valid || record.sequence > hotstart_record.sequence) {
+            hotstart_record = record;
+            hotstart_page = page;
+            hotstart_sequence = record.sequence;
+            hotstart_valid = true;
+        }
+    }
+
+    if(!hotstart_valid) {
+        return false;
+    }
+
+    //UBX-MGA-INI-POS_LLH, the modul expects the height above the ellipsoid
+    //but the difference to the sea level is far below the accuracy
+    int32_t altitude = hotstart_record.altitude / 10;
+    uint8_t payload[20] = {
+        0x01, 0x00, 0x00, 0x00,
+        (uint8_t)hotstart_record.latitude,
+        (uint8_t)(hotstart_record.latitude >> 8),
+        (uint8_t)(hotstart_record.latitude >> 16),
+        (uint8_t)(hotstart_record.latitude >> 24),
+        (uint8_t)hotstart_record.longitude,
+        (uint8_t)(hotstart_record.longitude >> 8),
+        (uint8_t)(hotstart_record.longitude >> 16),
+        (uint8_t)(hotstart_record.longitude >> 24),
+        (uint8_t)altitude, (uint8_t)(altitude >> 8),
+        (uint8_t)(altitude >> 16), (uint8_t)(altitude >> 24),
+        (uint8_t)HOTSTART_POSITION_ACCURACY,
+        (uint8_t)(HOTSTART_POSITION_ACCURACY >> 8),
+        (uint8_t)(HOTSTART_POSITION_ACCURACY >> 16),
+        (uint8_t)(HOTSTART_POSITION_ACCURACY >> 24),
+    };
+    gps_send_ubx(0x13, 0x40, payload, sizeof(payload));
+
+    return true;
+}
+
+//this function takes the fix as newest record for the data flash, the
+//flash task writes it with hotstart_update. The records are written one
+//after the other over the whole data flash
+//returns false when the fix has no position
+bool hotstart_save(const gps_fix_t* fix) {
+    uint32_t first_fix_ms, good_satellites_ms;
+
+    if(fix->sequence == 0) {
+        return false;
+    }
+
+    gps_get_start_times(&first_fix_ms, &good_satellites_ms);
+
+    //the sequence and the checksum are set when the write starts
+    memset(&hotstart_queued, 0, sizeof(hotstart_queued));
+    hotstart_queued.magic = HOTSTART_MAGIC;
+    hotstart_queued.latitude = fix->latitude;
+    hotstart_queued.longitude = fix->longitude;
+    hotstart_queued.altitude = fix->altitude;
+    hotstart_queued.date = fix->date;
+    hotstart_queued.time_ms = fix->time_ms;
+    hotstart_queued.tracking_s = (fix->timestamp - first_fix_ms) / 1000;
+    hotstart_queued_valid = true;
+    return true;
+}
+
+//this function is the flash task, it starts the write of the queued record
+//and goes on with the next step when the NVMCTRL has finished the last one.
+//A new row is erased before its first page is written
+void hotstart_update(void) {
+    if(NVMCTRL_IsBusy()) {
+        return;
+    }
+
+    switch(hotstart_step) {
+    case HOTSTART_IDLE:
+        if(!hotstart_queued_valid) {
+            return;
+        }
+        hotstart_written = hotstart_queued;
+        hotstart_queued_valid = false;
+        hotstart_written.sequence = hotstart_sequence + 1;
+        hotstart_written.checksum = hotstart_checksum(&hotstart_written);
+
+        //the next page, a page which is not erased in the middle of a row
+        //can only come from a broken write, then the next row will be used
+        hotstart_written_page = (uint8_t)((hotstart_page + 1)
+                % HOTSTART_PAGES);
+        if((hotstart_written_page % HOTSTART_PAGES_PER_ROW) != 0
+                && !hotstart_page_erased(hotstart_written_page)) {
+            hotstart_written_page = (uint8_t)((hotstart_written_page
+                    / HOTSTART_PAGES_PER_ROW + 1) * HOTSTART_PAGES_PER_ROW
+                    % HOTSTART_PAGES);
+        }
+        if((hotstart_written_page % HOTSTART_PAGES_PER_ROW) == 0) {
+            NVMCTRL_DATA_FLASH_RowErase(
+                    hotstart_address(hotstart_written_page));
+            hotstart_step = HOTSTART_ERASING;
+            return;
+        }
+        //without an erase the page is written at once
+        //fall through
+    case HOTSTART_ERASING:
+        NVMCTRL_DATA_FLASH_PageWrite((uint32_t*)&hotstart_written,
+                hotstart_address(hotstart_written_page));
+        hotstart_step = HOTSTART_WRITING;
+        return;
+    case HOTSTART_WRITING:
+        hotstart_page = hotstart_written_page;
+        hotstart_sequence = hotstart_written.sequence;
+        hotstart_step = HOTSTART_IDLE;
+        return;
+    default:
+        hotstart_step = HOTSTART_IDLE;
+        return;
+    }
+}
+
+//this function returns the record which was read at the start or NULL when
+//there was no valid record
+const hotstart_record_t* hotstart_get_record(void) {
+    return hotstart_valid ? &hotstart_record : NULL;
+}
+
+//this function calculates the time in seconds between the record of the
+//start and the fix, returns false when the date of one of them is unknown
+bool hotstart_get_age(const gps_fix_t* fix, uint32_t* age_s) {
+    if(!hotstart_valid || hotstart_record.date == 0 || fix->date == 0) {
+        return false;
+    }
+
+    uint32_t then = hotstart_seconds(hotstart_record.date,
+            hotstart_record.time_ms);
+    uint32_t now = hotstart_seconds(fix->date, fix->time_ms);
+    if(then == 0 || now < then) {
+        return false;
+    }
+
+    *age_s = now - then;
+    return true;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/** hotstart
+
+  @Company
+    Schindelar
+
+  @File Name
+    hotstart.h
+
+  @Summary
+    Last good fix of the gps modul in the data flash, it is sent to the modul
+    as aiding data after the start to shorten the time to the first fix
+ */
+/* ************************************************************************** */
+
+#ifndef _HOTSTART_H    /* Guard against multiple inclusion */
+#define _HOTSTART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gps.h"
+
+//accuracy of the stored position for the aiding in centimetres, the drone
+//can be carried to another start position between two flights
+#define HOTSTART_POSITION_ACCURACY 500000UL
+
+//the almanac of the gps modul is complete after 12.5 minutes of tracking
+#define HOTSTART_ALMANAC_TRACKING_S 750
+
+//record of the last good fix, it fills exactly one page of the data flash
+typedef struct {
+    uint32_t magic;         //HOTSTART_MAGIC for a written record
+    uint32_t sequence;      //the newest record has the highest sequence
+    int32_t latitude;       //latitude in 1e-7 degrees
+    int32_t longitude;      //longitude in 1e-7 degrees
+    int32_t altitude;       //altitude above sea level in millimetres
+    uint32_t date;          //utc date as ddmmyy, 0 when it was not known
+    uint32_t time_ms;       //utc time of the day in milliseconds
+    uint32_t tracking_s;    //seconds with a fix before the record, this is
+                            //the age marker of the almanac in the modul
+    uint32_t reserved[7];
+    uint32_t checksum;      //inverted sum of all words before
+} hotstart_record_t;
+
+//this function reads the newest record from the data flash and sends the
+//position to the gps modul as aiding data.
+//returns false when there is no valid record
+bool hotstart_restore(void);
+
+//this function takes the fix as newest record for the data flash, the
+//flash task writes it with hotstart_update. The records are written one
+//after the other over the whole data flash
+//returns false when the fix has no position
+bool hotstart_save(const gps_fix_t* fix);
+
+//this function is the flash task, it starts the write of the queued record
+//and goes on with the next step when the NVMCTRL has finished the last one.
+//A new row is erased before its first page is written
+void hotstart_update(void);
+
+//this function returns the record which was read at the start or NULL when
+//there was no valid record
+const hotstart_record_t* hotstart_get_record(void);
+
+//this function calculates the time in seconds between the record of the
+//start and the fix, returns false when the date of one of them is unknown
+bool hotstart_get_age(const gps_fix_t* fix, uint32_t* age_s);
+
+#endif /* _HOTSTART_H */
+
+/* *****************************************************************************
+ End of File
+ */
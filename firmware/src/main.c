@@ -27,6 +27,38 @@
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include "definitions.h"                // SYS function prototypes
 #include "flugprotokoll.h"              //defines the flight process functions
+#include "gps.h"                        //defines the gps receive functions
+#include "systime.h"                    //defines the system time functions
+#include "uart_line.h"                  //defines the bluetooth and flight controller lines
+#include "hotstart.h"                   //defines the hot start functions
+#include "divas_math.h"                 //defines the hardware division functions
+#include "timer.h"                      //defines the software timers
+#include "scheduler.h"                  //defines the tasks of the main loop
+#include "control_tick.h"               //defines the control tick of TC0
+#include "power.h"                      //defines the sleep of the cpu
+#include "geo_benchmark.h"              //defines the benchmark of the geodesy
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Tasks
+// *****************************************************************************
+// *****************************************************************************
+
+//the tasks of the main loop in the order of the SCHEDULER_TASK_ indices,
+//the budgets are in microseconds of the 48 MHz cpu. The NAV and the FC task
+//are released by the control tick, every run of the NAV task is one pass of
+//the flight process and one control tick along the leg
+const scheduler_task_t scheduler_tasks[SCHEDULER_TASK_COUNT] = {
+    //name, function, period in ms, priority, budget in us
+    {"FC", flight_controller_task, SCHEDULER_PERIOD_RELEASE, 0, 300},
+    {"GPS", gps_update, 5, 1, 1000},
+    {"NAV", navigation_task, SCHEDULER_PERIOD_RELEASE, 2, 2000},
+    {"TIMER", timer_update, 10, 3, 100},
+    {"BT", bluetooth_task, 20, 4, 1000},
+    {"LOAD", load_cell_task, 100, 5, 500},
+    {"LOG", logging_task, 1000, 6, 1000},
+    {"FLASH", hotstart_update, 10, 7, 200},
+};
 
 // *****************************************************************************
 // *****************************************************************************
@@ -39,23 +71,62 @@ int main ( void )
     /* Initialize all modules */
     SYS_Initialize ( NULL );
     
+    //the integer divisions and square roots of the control path run on
+    //the DIVAS
+    divas_initialize();
+    
+    //start the monotonic system time, the continous receiving of the
+    //gps sentences at SERCOM3 and of the lines at SERCOM2 and SERCOM1
+    systime_initialize();
+    
+    //measure the DIVAS against the software division of libgcc and the
+    //software square root with the running SysTick, the result is in the
+    //report
+    divas_benchmark();
+    
+    //measure the integer geodesy of one fix and of one leg against the old
+    //soft float distance() and courseTO(), the result is in the report
+    geo_benchmark();
+    gps_initialize();
+    uart_line_initialize();
+    
+    //switch the gps modul to the required sentences, update rate and
+    //baud rate, it keeps the factory setting when it does not answer
+    gps_configure();
+    
+    //send the last position from the data flash to the gps modul to shorten
+    //the time to the first fix
+    hotstart_restore();
+    
     //set the flight process to true to be able to start a new flight
     set_fly_process(true);
     
+    //release all tasks from now on, the control tasks with the control tick
+    scheduler_initialize();
+    control_tick_initialize(CONTROL_TICK_RATE_HZ);
+    
+    //sleep in IDLE when no task is due and switch off the unused clocks
+    power_initialize();
+    
     //endless loob
     while ( true )
     {
         /* Maintain state machines of all polled MPLAB Harmony modules. */
         SYS_Tasks ( );
         
-        //while there is a flight process
-        while(get_fly_process()) {
-            SYS_Tasks ( );
-           
-            //use the full flight protocoll function from flugprotokoll.c
-            fly_process();
+        //the control tick releases the flight process and the output to the
+        //flight controller
+        if(control_tick_take()) {
+            scheduler_release(SCHEDULER_TASK_NAVIGATION);
+            scheduler_release(SCHEDULER_TASK_FLIGHT_CONTROLLER);
         }
         
+        //run the due task with the highest priority, the flight process is
+        //the navigation task. Without a due task the cpu sleeps until the
+        //next interrupt
+        if(!scheduler_run()) {
+            power_idle();
+        }
     }
 
     /* Execution should not come here during normal operation */
@@ -0,0 +1,427 @@
+/* ************************************************************************** */
+/** nmea
+
+  @Company
+    Schindelar
+
+  @File Name
+    nmea.c
+
+  @Summary
+    Single pass tokenizer and integer decoder for the nmea sentences of the
+    gps modul. The fields are not copied, they point directly into the
+    received line and all numbers are parsed straight into integers, so no
+    sscanf and no soft float strtod is needed on the Cortex-M0+.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <string.h>
+#include "nmea.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function changes a hex character into its value or -1 if it is no hex
+static int8_t nmea_hex_value(char c) {
+    if(c >= '0' && c <= '9') {
+        return (int8_t)(c - '0');
+    }
+    if(c >= 'A' && c <= 'F') {
+        return (int8_t)(c - 'A' + 10);
+    }
+    if(c >= 'a' && c <= 'f') {
+        return (int8_t)(c - 'a' + 10);
+    }
+    return -1;
+}
+
+//this function saves one field in the sentence
+static bool nmea_add_field(nmea_sentence_t* sentence, const char* start,
+        const char* end) {
+    if(sentence->field_count >= NMEA_MAX_FIELDS) {
+        return false;
+    }
+    sentence->field[sentence->field_count].text = start;
+    sentence->field[sentence->field_count].length = (uint8_t)(end - start);
+    sentence->field_count++;
+    return true;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function walks once through the sentence, splits it into its fields
+//and checks the *hh checksum at the end.
+//returns false when the sentence is broken or the checksum is wrong
+bool nmea_tokenize(const char* line, nmea_sentence_t* sentence) {
+    uint8_t checksum = 0;
+    const char* position = line;
+    const char* field_start;
+    int8_t high, low;
+
+    sentence->field_count = 0;
+
+    if(*position != '$') {
+        return false;
+    }
+    position++;
+    field_start = position;
+
+    //the checksum is the xor of all characters between '$' and '*'
+    while(*position != '*') {
+        if(*position == '\0') {
+            return false;   //there is no checksum
+        }
+        if(*position == ',') {
+            if(!nmea_add_field(sentence, field_start, position)) {
+                return false;
+            }
+            field_start = position + 1;
+        }
+        checksum ^= (uint8_t)*position;
+        position++;
+    }
+
+    if(!nmea_add_field(sentence, field_start, position)) {
+        return false;
+    }
+
+    high = nmea_hex_value(position[1]);
+    low = (high < 0) ? -1 : nmea_hex_value(position[2]);
+    if(low < 0) {
+        return false;
+    }
+
+    return (uint8_t)((high << 4) | low) == checksum;
+}
+
+//this function checks the sentence type without the talker, e.g. "GGA"
+bool nmea_is_type(const nmea_sentence_t* sentence, const char* type) {
+    const nmea_field_t* address = &sentence->field[0];
+    if(sentence->field_count == 0 || address->length != 5) {
+        return false;
+    }
+    return memcmp(address->text + 2, type, 3) == 0;
+}
+
+//this function parses a field with digits only into an unsigned integer
+bool nmea_parse_unsigned(const nmea_field_t* field, uint32_t* value) {
+    uint32_t result = 0;
+
+    if(field->length == 0) {
+        return false;
+    }
+
+    for(uint8_t i = 0; i < field->length; i++) {
+        char c = field->text[i];
+        if(c < '0' || c > '9') {
+            return false;
+        }
+        result = result * 10 + (uint32_t)(c - '0');
+    }
+
+    *value = result;
+    return true;
+}
+
+//this function parses a decimal number like -12.345 into a fixed point
+//integer with the given amount of decimals, the rest will be cut off. It
+//returns false when the number does not fit into 32 bits
+bool nmea_parse_fixed(const nmea_field_t* field, uint8_t decimals,
+        int32_t* value) {
+    int32_t result = 0;
+    uint8_t fraction = 0;
+    uint8_t i = 0;
+    bool negative = false;
+    bool point = false;
+    bool digits = false;
+
+    if(field->length > 0 && field->text[0] == '-') {
+        negative = true;
+        i = 1;
+    }
+
+    for(; i < field->length; i++) {
+        char c = field->text[i];
+        if(c == '.') {
+            if(point) {
+                return false;
+            }
+            point = true;
+            continue;
+        }
+        if(c < '0' || c > '9') {
+            return false;
+        }
+        if(point) {
+            if(fraction >= decimals) {
+                continue;   //more decimals than required
+            }
+            fraction++;
+        }
+        //a number with too many digits for 32 bits is not valid
+        if(result > (INT32_MAX - 9) / 10) {
+            return false;
+        }
+        result = result * 10 + (c - '0');
+        digits = true;
+    }
+
+    if(!digits) {
+        return false;
+    }
+
+    //fill up the missing decimals
+    while(fraction < decimals) {
+        if(result > INT32_MAX / 10) {
+            return false;
+        }
+        result *= 10;
+        fraction++;
+    }
+
+    *value = negative ? -result : result;
+    return true;
+}
+
+//this function parses a position in the degrees minutes format (d)ddmm.mmmmm
+//with its hemisphere N/S/E/W into 1e-7 degrees
+bool nmea_parse_coordinate(const nmea_field_t* field,
+        const nmea_field_t* hemisphere, int32_t* value) {
+    uint32_t integer = 0;
+    uint32_t fraction = 0;
+    uint8_t fraction_digits = 0;
+    bool point = false;
+
+    if(field->length < 4 || hemisphere->length != 1) {
+        return false;
+    }
+
+    for(uint8_t i = 0; i < field->length; i++) {
+        char c = field->text[i];
+        if(c == '.') {
+            if(point) {
+                return false;
+            }
+            point = true;
+            continue;
+        }
+        if(c < '0' || c > '9') {
+            return false;
+        }
+        if(!point) {
+            integer = integer * 10 + (uint32_t)(c - '0');
+        } else if(fraction_digits < 7) {
+            fraction = fraction * 10 + (uint32_t)(c - '0');
+            fraction_digits++;
+        }
+    }
+
+    //the fraction of the minutes is always used with 7 decimals
+    while(fraction_digits < 7) {
+        fraction *= 10;
+        fraction_digits++;
+    }
+
+    //the last two digits before the point are the minutes
+    uint32_t degrees = integer / 100;
+    uint32_t minutes = (integer % 100) * 10000000UL + fraction;
+    int32_t result = (int32_t)(degrees * 10000000UL + (minutes + 30) / 60);
+
+    switch(hemisphere->text[0]) {
+        case('N'):
+        case('E'):
+            break;
+        case('S'):
+        case('W'):
+            result = -result;
+            break;
+        default:
+            return false;
+    }
+
+    *value = result;
+    return true;
+}
+
+//this function parses the time hhmmss.ss into milliseconds of the day
+bool nmea_parse_time(const nmea_field_t* field, uint32_t* value) {
+    int32_t time;
+
+    if(field->length < 6 || !nmea_parse_fixed(field, 3, &time) || time < 0) {
+        return false;
+    }
+
+    //time is now hhmmssfff
+    uint32_t hours = (uint32_t)time / 10000000UL;
+    uint32_t minutes = ((uint32_t)time / 100000UL) % 100;
+    uint32_t milliseconds = (uint32_t)time % 100000UL;
+
+    *value = hours * 3600000UL + minutes * 60000UL + milliseconds;
+    return true;
+}
+
+//this function decodes a tokenized GGA sentence
+bool nmea_parse_gga(const nmea_sentence_t* sentence, nmea_gga_t* gga) {
+    const nmea_field_t* field = sentence->field;
+    uint32_t number;
+    int32_t fixed;
+
+    if(!nmea_is_type(sentence, "GGA") || sentence->field_count < 10) {
+        return false;
+    }
+
+    //the quality field is always there, all other fields are empty as long as
+    //the gps modul has no fix
+    if(!nmea_parse_unsigned(&field[6], &number)) {
+        return false;
+    }
+    gga->quality = (uint8_t)number;
+
+    if(!nmea_parse_time(&field[1], &gga->time_ms)) {
+        gga->time_ms = 0;
+    }
+
+    gga->satellites = nmea_parse_unsigned(&field[7], &number) ?
+            (uint8_t)number : 0;
+    gga->hdop = nmea_parse_fixed(&field[8], 2, &fixed) ?
+            (uint16_t)fixed : UINT16_MAX;
+
+    if(gga->quality == 0) {
+        gga->latitude = 0;
+        gga->longitude = 0;
+        gga->altitude = 0;
+        return true;
+    }
+
+    return nmea_parse_coordinate(&field[2], &field[3], &gga->latitude)
+            && nmea_parse_coordinate(&field[4], &field[5], &gga->longitude)
+            && nmea_parse_fixed(&field[9], 2, &gga->altitude);
+}
+
+//this function decodes a tokenized GSV sentence
+bool nmea_parse_gsv(const nmea_sentence_t* sentence, nmea_gsv_t* gsv) {
+    const nmea_field_t* field = sentence->field;
+    uint32_t number;
+    int32_t fixed;
+
+    if(!nmea_is_type(sentence, "GSV") || sentence->field_count < 4) {
+        return false;
+    }
+
+    gsv->talker[0] = field[0].text[0];
+    gsv->talker[1] = field[0].text[1];
+
+    if(!nmea_parse_unsigned(&field[1], &number)) {
+        return false;
+    }
+    gsv->message_count = (uint8_t)number;
+
+    if(!nmea_parse_unsigned(&field[2], &number)) {
+        return false;
+    }
+    gsv->message_number = (uint8_t)number;
+
+    gsv->satellites_in_view = nmea_parse_unsigned(&field[3], &number) ?
+            (uint8_t)number : 0;
+
+    //every satellite has 4 fields, a trailing signal id will be ignored
+    gsv->satellite_count = 0;
+    for(uint8_t base = 4; (base + 3) < sentence->field_count
+            && gsv->satellite_count < NMEA_GSV_SATELLITES; base += 4) {
+        nmea_gsv_satellite_t* satellite =
+                &gsv->satellite[gsv->satellite_count];
+
+        if(!nmea_parse_unsigned(&field[base], &number)) {
+            continue;
+        }
+        satellite->prn = (uint16_t)number;
+        satellite->elevation = nmea_parse_fixed(&field[base + 1], 0, &fixed) ?
+                (int8_t)fixed : 0;
+        satellite->azimuth = nmea_parse_unsigned(&field[base + 2], &number) ?
+                (uint16_t)number : 0;
+        satellite->signal_strength =
+                nmea_parse_unsigned(&field[base + 3], &number) ?
+                (int8_t)number : -1;
+        gsv->satellite_count++;
+    }
+
+    return true;
+}
+
+//this function decodes a tokenized RMC sentence
+bool nmea_parse_rmc(const nmea_sentence_t* sentence, nmea_rmc_t* rmc) {
+    const nmea_field_t* field = sentence->field;
+    int32_t fixed;
+
+    if(!nmea_is_type(sentence, "RMC") || sentence->field_count < 10) {
+        return false;
+    }
+
+    if(!nmea_parse_time(&field[1], &rmc->time_ms)) {
+        rmc->time_ms = 0;
+    }
+    if(!nmea_parse_unsigned(&field[9], &rmc->date)) {
+        rmc->date = 0;
+    }
+
+    rmc->valid = (field[2].length == 1 && field[2].text[0] == 'A');
+    if(!rmc->valid) {
+        return true;
+    }
+
+    if(!nmea_parse_coordinate(&field[3], &field[4], &rmc->latitude)
+            || !nmea_parse_coordinate(&field[5], &field[6], &rmc->longitude)) {
+        return false;
+    }
+
+    //speed in knots with 3 decimals, one knot is 1852 m/h
+    rmc->speed = nmea_parse_fixed(&field[7], 3, &fixed) && fixed >= 0 ?
+            ((uint32_t)fixed * 1852UL + 1800UL) / 3600UL : 0;
+
+    rmc->course = nmea_parse_fixed(&field[8], 2, &fixed) ? fixed : -1;
+
+    return true;
+}
+
+//this function decodes a tokenized VTG sentence
+bool nmea_parse_vtg(const nmea_sentence_t* sentence, nmea_vtg_t* vtg) {
+    const nmea_field_t* field = sentence->field;
+    int32_t fixed;
+
+    if(!nmea_is_type(sentence, "VTG") || sentence->field_count < 9) {
+        return false;
+    }
+
+    //the mode indicator N means that the modul has no valid fix
+    vtg->valid = !(sentence->field_count > 9 && field[9].length == 1
+            && field[9].text[0] == 'N');
+
+    //speed in km/h with 3 decimals, this are metres per hour
+    if(nmea_parse_fixed(&field[7], 3, &fixed) && fixed >= 0) {
+        vtg->speed = ((uint32_t)fixed * 10UL + 18UL) / 36UL;
+    } else {
+        vtg->speed = 0;
+        vtg->valid = false;
+    }
+
+    vtg->course = nmea_parse_fixed(&field[1], 2, &fixed) ? fixed : -1;
+
+    return true;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/** nmea
+
+  @Company
+    Schindelar
+
+  @File Name
+    nmea.h
+
+  @Summary
+    Single pass tokenizer and integer decoder for the nmea sentences of the
+    gps modul
+ */
+/* ************************************************************************** */
+
+#ifndef _NMEA_H    /* Guard against multiple inclusion */
+#define _NMEA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//a GSV sentence has the most fields with 21, the rest is a safety margin
+#define NMEA_MAX_FIELDS 24
+
+//the maximum amount of satellites in one GSV sentence
+#define NMEA_GSV_SATELLITES 4
+
+//one field of a sentence, it points directly into the received line
+//and is not terminated with a 0
+typedef struct {
+    const char* text;
+    uint8_t length;
+} nmea_field_t;
+
+//all fields of one sentence, field 0 is the address like GNGGA
+typedef struct {
+    nmea_field_t field[NMEA_MAX_FIELDS];
+    uint8_t field_count;
+} nmea_sentence_t;
+
+//decoded GGA sentence
+//$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,*4C
+typedef struct {
+    uint32_t time_ms;       //utc time of the day in milliseconds
+    int32_t latitude;       //latitude in 1e-7 degrees, south is negative
+    int32_t longitude;      //longitude in 1e-7 degrees, west is negative
+    uint8_t quality;        //fix quality, 0 means there is no fix
+    uint8_t satellites;     //amount of used satellites
+    uint16_t hdop;          //horizontal dilution of precision in 1/100
+    int32_t altitude;       //altitude above sea level in centimetres
+} nmea_gga_t;
+
+//data of one satellite in a GSV sentence
+typedef struct {
+    uint16_t prn;           //number of the satellite, can be above 255
+    int8_t elevation;       //elevation in degrees
+    uint16_t azimuth;       //azimuth in degrees
+    int8_t signal_strength; //signal strength in dB, -1 when it is not tracked
+} nmea_gsv_satellite_t;
+
+//decoded GSV sentence
+//$GPGSV,3,1,11,01,12,042,28,03,64,108,43,04,39,196,40,06,04,312,*7B
+typedef struct {
+    char talker[2];         //GP, GL, GA, GB ...
+    uint8_t message_count;  //amount of GSV sentences of this talker
+    uint8_t message_number; //number of this sentence starting with 1
+    uint8_t satellites_in_view;
+    uint8_t satellite_count;    //amount of satellites in this sentence
+    nmea_gsv_satellite_t satellite[NMEA_GSV_SATELLITES];
+} nmea_gsv_t;
+
+//decoded RMC sentence
+//$GNRMC,100855.00,A,4804.43802,N,01617.42769,E,0.012,77.52,170623,,,A*7C
+typedef struct {
+    uint32_t time_ms;       //utc time of the day in milliseconds
+    bool valid;             //true when the status is A
+    int32_t latitude;       //latitude in 1e-7 degrees
+    int32_t longitude;      //longitude in 1e-7 degrees
+    uint32_t speed;         //speed over ground in mm/s
+    int32_t course;         //course over ground in 1/100 degrees, -1 if empty
+    uint32_t date;          //date as ddmmyy
+} nmea_rmc_t;
+
+//decoded VTG sentence
+//$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*3D
+typedef struct {
+    bool valid;             //false when the mode is N or the fields are empty
+    uint32_t speed;         //speed over ground in mm/s
+    int32_t course;         //course over ground in 1/100 degrees, -1 if empty
+} nmea_vtg_t;
+
+//this function walks once through the sentence, splits it into its fields
+//and checks the *hh checksum at the end.
+//returns false when the sentence is broken or the checksum is wrong
+bool nmea_tokenize(const char* line, nmea_sentence_t* sentence);
+
+//this function checks the sentence type without the talker, e.g. "GGA"
+bool nmea_is_type(const nmea_sentence_t* sentence, const char* type);
+
+//this function parses a field with digits only into an unsigned integer
+bool nmea_parse_unsigned(const nmea_field_t* field, uint32_t* value);
+
+//this function parses a decimal number like -12.345 into a fixed point
+//integer with the given amount of decimals, the rest will be cut off. It
+//returns false when the number does not fit into 32 bits
+bool nmea_parse_fixed(const nmea_field_t* field, uint8_t decimals,
+        int32_t* value);
+
+//this function parses a position in the degrees minutes format (d)ddmm.mmmmm
+//with its hemisphere N/S/E/W into 1e-7 degrees
+bool nmea_parse_coordinate(const nmea_field_t* field,
+        const nmea_field_t* hemisphere, int32_t* value);
+
+//this function parses the time hhmmss.ss into milliseconds of the day
+bool nmea_parse_time(const nmea_field_t* field, uint32_t* value);
+
+//this function decodes a tokenized GGA sentence
+bool nmea_parse_gga(const nmea_sentence_t* sentence, nmea_gga_t* gga);
+
+//this function decodes a tokenized GSV sentence
+bool nmea_parse_gsv(const nmea_sentence_t* sentence, nmea_gsv_t* gsv);
+
+//this function decodes a tokenized RMC sentence
+bool nmea_parse_rmc(const nmea_sentence_t* sentence, nmea_rmc_t* rmc);
+
+//this function decodes a tokenized VTG sentence
+bool nmea_parse_vtg(const nmea_sentence_t* sentence, nmea_vtg_t* vtg);
+
+#endif /* _NMEA_H */
+
+/* *****************************************************************************
+ End of File
+ */
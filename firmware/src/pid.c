@@ -0,0 +1,94 @@
+/* ************************************************************************** */
+/** pid
+
+  @Company
+    Schindelar
+
+  @File Name
+    pid.c
+
+  @Summary
+    Integer PID controller for the position and altitude control. The gains
+    come from a parameter table of the caller, the controller only keeps the
+    integral and the last error. The integral is stopped while the output is
+    at a limit, so it can not wind up during a long leg.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "pid.h"
+#include "divas_math.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function resets the integral and the derivative of the controller,
+//it has to be called at the start of every leg
+void pid_reset(pid_state_t* state) {
+    state->integral = 0;
+    state->last_error = 0;
+    state->started = false;
+}
+
+//this function calculates the output of the controller for the error and
+//the time since the last sample in milliseconds. The derivative is 0 for the
+//first sample and the integral only grows while the output is not limited
+int32_t pid_update(const pid_parameter_t* parameter, pid_state_t* state,
+        int32_t error, uint32_t delta_ms) {
+    int32_t derivative = 0;
+    int32_t limit_ms = parameter->integral_limit * 1000;
+
+    //the change of the error per second, the change is limited so the
+    //product with 1000 fits into the 32 bits of the DIVAS. The difference of
+    //two errors far apart does not fit into 32 bits, so it is taken in 64
+    if(state->started && delta_ms > 0) {
+        int64_t change = (int64_t)error - state->last_error;
+        if(change > PID_CHANGE_LIMIT) {
+            change = PID_CHANGE_LIMIT;
+        } else if(change < -PID_CHANGE_LIMIT) {
+            change = -PID_CHANGE_LIMIT;
+        }
+        derivative = divas_divide((int32_t)change * 1000, (int32_t)delta_ms);
+    }
+    state->last_error = error;
+    state->started = true;
+
+    //the integral is split into error seconds and the rest in milliseconds,
+    //so only the rest is divided and the division fits into 32 bits
+    int32_t seconds = divas_divide(state->integral, 1000);
+    int32_t rest_ms = state->integral - seconds * 1000;
+    int64_t output = (int64_t)parameter->kp * error
+            + (int64_t)parameter->ki * seconds
+            + divas_divide(parameter->ki * rest_ms, 1000)
+            + (int64_t)parameter->kd * derivative;
+    output >>= PID_GAIN_SHIFT;
+
+    //the integral only grows while the output is inside the limits
+    if(output > parameter->output_max) {
+        output = parameter->output_max;
+    } else if(output < parameter->output_min) {
+        output = parameter->output_min;
+    } else {
+        int64_t integral = state->integral + (int64_t)error * delta_ms;
+        if(integral > limit_ms) {
+            integral = limit_ms;
+        } else if(integral < -limit_ms) {
+            integral = -limit_ms;
+        }
+        state->integral = (int32_t)integral;
+    }
+
+    return (int32_t)output;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,64 @@
+/* ************************************************************************** */
+/** pid
+
+  @Company
+    Schindelar
+
+  @File Name
+    pid.h
+
+  @Summary
+    Integer PID controller with the gains in a parameter table, the error is
+    in integer units like centimetres and the output in microseconds of the
+    flight controller channels
+ */
+/* ************************************************************************** */
+
+#ifndef _PID_H    /* Guard against multiple inclusion */
+#define _PID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//the gains are fixed point numbers with 8 fraction bits, 256 is 1.0
+#define PID_GAIN_SHIFT 8
+#define PID_GAIN_ONE (1L << PID_GAIN_SHIFT)
+
+//limit of the change of the error between two samples for the derivative,
+//the change times 1000 has to fit into the 32 bits of the DIVAS
+#define PID_CHANGE_LIMIT (INT32_MAX / 1000)
+
+//parameters of one controller
+typedef struct {
+    int32_t kp;             //output per error
+    int32_t ki;             //output per error and second, below
+                            //INT32_MAX / 1000 for the DIVAS
+    int32_t kd;             //output per error change per second
+    int32_t integral_limit; //limit of the integral in error seconds,
+                            //below INT32_MAX / 1000
+    int32_t output_min;     //limits of the output
+    int32_t output_max;
+} pid_parameter_t;
+
+//state of one controller between two samples
+typedef struct {
+    int32_t integral;       //sum of the error in error milliseconds
+    int32_t last_error;
+    bool started;           //false until the first sample
+} pid_state_t;
+
+//this function resets the integral and the derivative of the controller,
+//it has to be called at the start of every leg
+void pid_reset(pid_state_t* state);
+
+//this function calculates the output of the controller for the error and
+//the time since the last sample in milliseconds. The derivative is 0 for the
+//first sample and the integral only grows while the output is not limited
+int32_t pid_update(const pid_parameter_t* parameter, pid_state_t* state,
+        int32_t error, uint32_t delta_ms);
+
+#endif /* _PID_H */
+
+/* *****************************************************************************
+ End of File
+ */
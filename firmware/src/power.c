@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/** power
+
+  @Company
+    Schindelar
+
+  @File Name
+    power.c
+
+  @Summary
+    Sleep of the cpu in the main loop. When no task is due the cpu waits
+    with WFI in the IDLE sleep, only the cpu clock stops and the generic
+    clocks, the SysTick, the timers and the SERCOMs go on, so every
+    interrupt wakes it up within a few cycles. The time in the sleep is
+    measured with the system time and gives the idle share and an estimate
+    of the mean current. STANDBY is not used, in it the 48 MHz clock of the
+    system time and of the uarts would stop and the sentences of the gps
+    modul would be lost, which arrive during the whole flight.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "definitions.h"
+#include "power.h"
+#include "systime.h"
+#include "control_tick.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//time in the sleep since the reset of the statistic and the start of the
+//statistic in microseconds
+static uint64_t power_idle_us = 0;
+static uint64_t power_stats_start_us = 0;
+
+//true while the clocks of the load cell SERCOM are switched on
+static bool power_load_cell_on = true;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function selects the IDLE sleep and switches off the clocks of the
+//peripherals which are not used
+void power_initialize(void) {
+    PM_REGS->PM_SLEEPCFG = PM_SLEEPCFG_SLEEPMODE_IDLE;
+    while((PM_REGS->PM_SLEEPCFG & PM_SLEEPCFG_SLEEPMODE_Msk)
+            != PM_SLEEPCFG_SLEEPMODE_IDLE);
+
+    //TC1 was the timer of the old delays and is not used anymore, its
+    //generic clock is shared with the control tick of TC0 and stays on
+    MCLK_REGS->MCLK_APBCMASK &= ~MCLK_APBCMASK_TC1_Msk;
+
+    power_reset_stats();
+}
+
+//this function lets the cpu sleep until the next interrupt, it is called
+//by the main loop when no task was due. The SysTick, the control tick and
+//the receive interrupts of the uarts wake it up
+void power_idle(void) {
+    uint32_t start_us = systime_get_us();
+
+    //with the interrupts disabled a tick which comes after the check still
+    //wakes up the WFI, its handler runs after the interrupts are enabled
+    __disable_irq();
+    if(!control_tick_is_pending()) {
+        __DSB();
+        __WFI();
+    }
+    __enable_irq();
+
+    power_idle_us += systime_get_us() - start_us;
+}
+
+//this function switches the clocks of the SERCOM of the load cell on or
+//off, they are only needed while the payload is checked
+void power_set_load_cell(bool on) {
+    if(on == power_load_cell_on) {
+        return;
+    }
+
+    if(on) {
+        MCLK_REGS->MCLK_APBCMASK |= MCLK_APBCMASK_SERCOM0_Msk;
+        GCLK_REGS->GCLK_PCHCTRL[SERCOM0_GCLK_ID_CORE] |= GCLK_PCHCTRL_CHEN_Msk;
+        while((GCLK_REGS->GCLK_PCHCTRL[SERCOM0_GCLK_ID_CORE]
+                & GCLK_PCHCTRL_CHEN_Msk) != GCLK_PCHCTRL_CHEN_Msk);
+    } else {
+        GCLK_REGS->GCLK_PCHCTRL[SERCOM0_GCLK_ID_CORE] &= ~GCLK_PCHCTRL_CHEN_Msk;
+        while(GCLK_REGS->GCLK_PCHCTRL[SERCOM0_GCLK_ID_CORE]
+                & GCLK_PCHCTRL_CHEN_Msk);
+        MCLK_REGS->MCLK_APBCMASK &= ~MCLK_APBCMASK_SERCOM0_Msk;
+    }
+    power_load_cell_on = on;
+}
+
+//this function returns the share of the time in the sleep since the reset
+//of the statistic in 1/100 percent
+uint16_t power_get_idle(void) {
+    uint64_t elapsed_us = systime_get_us64() - power_stats_start_us;
+
+    if(elapsed_us == 0) {
+        return 0;
+    }
+    uint64_t share = (power_idle_us * 10000ULL) / elapsed_us;
+    return (uint16_t)((share > 10000) ? 10000 : share);
+}
+
+//this function returns the estimated mean current of the cpu since the
+//reset of the statistic in microamperes
+uint32_t power_get_current_ua(void) {
+    uint32_t idle = power_get_idle();
+    uint32_t current = (POWER_ACTIVE_UA * (10000 - idle)
+            + POWER_IDLE_UA * idle) / 10000;
+
+    if(power_load_cell_on) {
+        current += POWER_LOAD_CELL_UA;
+    }
+    return current;
+}
+
+//this function resets the statistic of the sleep
+void power_reset_stats(void) {
+    power_idle_us = 0;
+    power_stats_start_us = systime_get_us64();
+}
+
+/* *****************************************************************************
+ End of File
+ */
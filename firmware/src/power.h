@@ -0,0 +1,60 @@
+/* ************************************************************************** */
+/** power
+
+  @Company
+    Schindelar
+
+  @File Name
+    power.h
+
+  @Summary
+    Sleep of the cpu in the main loop when no task is due, the switching of
+    the peripheral clocks which are not needed and the measurement of the
+    idle time with an estimate of the current
+ */
+/* ************************************************************************** */
+
+#ifndef _POWER_H    /* Guard against multiple inclusion */
+#define _POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//typical current of the cpu with the flash at 48 MHz in microamperes while
+//it runs and while it sleeps in IDLE, the values are not measured on the
+//board and only give an estimate
+#define POWER_ACTIVE_UA 4100
+#define POWER_IDLE_UA 1600
+
+//typical current of the load cell SERCOM with its clocks in microamperes
+#define POWER_LOAD_CELL_UA 100
+
+//this function selects the IDLE sleep and switches off the clocks of the
+//peripherals which are not used
+void power_initialize(void);
+
+//this function lets the cpu sleep until the next interrupt, it is called
+//by the main loop when no task was due. The SysTick, the control tick and
+//the receive interrupts of the uarts wake it up
+void power_idle(void);
+
+//this function switches the clocks of the SERCOM of the load cell on or
+//off, they are only needed while the payload is checked
+void power_set_load_cell(bool on);
+
+//this function returns the share of the time in the sleep since the reset
+//of the statistic in 1/100 percent
+uint16_t power_get_idle(void);
+
+//this function returns the estimated mean current of the cpu since the
+//reset of the statistic in microamperes
+uint32_t power_get_current_ua(void);
+
+//this function resets the statistic of the sleep
+void power_reset_stats(void);
+
+#endif /* _POWER_H */
+
+/* *****************************************************************************
+ End of File
+ */
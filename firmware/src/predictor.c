@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/** predictor
+
+  @Company
+    Schindelar
+
+  @File Name
+    predictor.c
+
+  @Summary
+    Alpha beta filter for the position and the velocity of the drone. The
+    gps modul delivers 1 to 10 fixes in a second, between them the position
+    is moved on with the velocity and the system time, so the control loop
+    gets a new estimate at every tick. Every fix corrects the prediction,
+    alpha is smaller for a fix with a bad HDOP and beta is calculated from
+    alpha for a critically damped filter.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "predictor.h"
+#include "divas_math.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function moves a position with the velocity in centimetres per second
+//for the time in microseconds
+static int32_t predictor_move(int32_t position, int32_t velocity,
+        uint32_t delta_us) {
+    return position + (int32_t)(((int64_t)velocity * delta_us) / 1000000);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function resets the filter, the next fix starts it again
+void predictor_reset(predictor_t* predictor) {
+    for(uint8_t i = 0; i < PREDICTOR_AXES; i++) {
+        predictor->position[i] = 0;
+        predictor->velocity[i] = 0;
+    }
+    predictor->time_us = 0;
+    predictor->valid = false;
+}
+
+//this function corrects the filter with the position of a fix in
+//centimetres, the HDOP of the fix in 1/100 and the receive time of the fix
+void predictor_correct(predictor_t* predictor, const int32_t* position,
+        uint16_t hdop, uint32_t time_us) {
+    uint32_t delta_us = time_us - predictor->time_us;
+
+    //the first fix or a fix after a long gap starts the filter at rest
+    if(!predictor->valid || delta_us == 0
+            || delta_us > PREDICTOR_MAX_GAP_US) {
+        for(uint8_t i = 0; i < PREDICTOR_AXES; i++) {
+            predictor->position[i] = position[i];
+            predictor->velocity[i] = 0;
+        }
+        predictor->time_us = time_us;
+        predictor->valid = true;
+        return;
+    }
+
+    //alpha gets smaller with a bigger HDOP, a HDOP below 1.0 counts as 1.0
+    int32_t alpha = PREDICTOR_ALPHA;
+    if(hdop > 100) {
+        alpha = divas_divide(PREDICTOR_ALPHA * 100, hdop);
+        if(alpha < PREDICTOR_ALPHA_MIN) {
+            alpha = PREDICTOR_ALPHA_MIN;
+        }
+    }
+    int32_t beta = divas_divide(alpha * alpha, 512 - alpha);
+
+    for(uint8_t i = 0; i < PREDICTOR_AXES; i++) {
+        int32_t predicted = predictor_move(predictor->position[i],
+                predictor->velocity[i], delta_us);
+        int32_t residual = position[i] - predicted;
+
+        predictor->position[i] = predicted + ((alpha * residual) >> 8);
+        predictor->velocity[i] += (int32_t)((((int64_t)beta * residual)
+                * 1000000 / delta_us) >> 8);
+    }
+    predictor->time_us = time_us;
+}
+
+//this function predicts the position in centimetres at the time now_us with
+//the velocity of the filter, returns false when the filter has no fix
+bool predictor_predict(const predictor_t* predictor, uint32_t now_us,
+        int32_t* position) {
+    if(!predictor->valid) {
+        return false;
+    }
+
+    //the prediction is not moved on further than the gap of a lost fix
+    uint32_t delta_us = now_us - predictor->time_us;
+    if(delta_us > PREDICTOR_MAX_GAP_US) {
+        delta_us = PREDICTOR_MAX_GAP_US;
+    }
+
+    for(uint8_t i = 0; i < PREDICTOR_AXES; i++) {
+        position[i] = predictor_move(predictor->position[i],
+                predictor->velocity[i], delta_us);
+    }
+    return true;
+}
+
+/* *****************************************************************************
+ End of File
+ */
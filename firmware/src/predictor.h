@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/** predictor
+
+  @Company
+    Schindelar
+
+  @File Name
+    predictor.h
+
+  @Summary
+    Alpha beta filter for the position and the velocity in the north east
+    frame of the leg, it predicts the position between two gps fixes with
+    the system time
+ */
+/* ************************************************************************** */
+
+#ifndef _PREDICTOR_H    /* Guard against multiple inclusion */
+#define _PREDICTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//axes of the predictor
+#define PREDICTOR_NORTH 0
+#define PREDICTOR_EAST 1
+#define PREDICTOR_AXES 2
+
+//alpha of the filter as Q8 at a HDOP of 1.0, with a higher HDOP the fix is
+//trusted less. Alpha can not go below the minimum, beta follows from alpha
+#define PREDICTOR_ALPHA 192
+#define PREDICTOR_ALPHA_MIN 32
+
+//a gap between two fixes which is longer than this restarts the filter at
+//the next fix, in microseconds
+#define PREDICTOR_MAX_GAP_US 2000000UL
+
+//state of the filter at the time of the last fix
+typedef struct {
+    int32_t position[PREDICTOR_AXES];   //position in centimetres
+    int32_t velocity[PREDICTOR_AXES];   //velocity in centimetres per second
+    uint32_t time_us;                   //systime_get_us of the last fix
+    bool valid;                         //false until the first fix
+} predictor_t;
+
+//this function resets the filter, the next fix starts it again
+void predictor_reset(predictor_t* predictor);
+
+//this function corrects the filter with the position of a fix in
+//centimetres, the HDOP of the fix in 1/100 and the receive time of the fix
+void predictor_correct(predictor_t* predictor, const int32_t* position,
+        uint16_t hdop, uint32_t time_us);
+
+//this function predicts the position in centimetres at the time now_us with
+//the velocity of the filter, returns false when the filter has no fix
+bool predictor_predict(const predictor_t* predictor, uint32_t now_us,
+        int32_t* position);
+
+#endif /* _PREDICTOR_H */
+
+/* *****************************************************************************
+ End of File
+ */
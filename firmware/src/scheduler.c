@@ -0,0 +1,227 @@
+/* ************************************************************************** */
+/** scheduler
+
+  @Company
+    Schindelar
+
+  @File Name
+    scheduler.c
+
+  @Summary
+    Cooperative fixed rate scheduler of the main loop. Every task has a
+    period, a priority and a budget. The due task with the highest priority
+    runs to its end, the next release is counted from the last one so the
+    rate does not drift. The execution time of every run is measured with
+    the system time and compared with the budget. A task which waits can
+    let the other tasks run with scheduler_yield, the time of the nested
+    tasks is not counted for the waiting task. A task without a period is
+    released from outside, for example by the control tick.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stddef.h>
+#include "scheduler.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//next release of every task in milliseconds of the 64 bit system time
+static uint64_t scheduler_release_ms[SCHEDULER_TASK_COUNT];
+
+//true when a task with the period SCHEDULER_PERIOD_RELEASE has been
+//released and has not run yet
+static bool scheduler_released[SCHEDULER_TASK_COUNT];
+
+//true while a task is running, a running task is not started again by
+//scheduler_yield
+static bool scheduler_running[SCHEDULER_TASK_COUNT];
+
+//statistic of every task and the start of the statistic
+static scheduler_stats_t scheduler_stats[SCHEDULER_TASK_COUNT];
+static uint64_t scheduler_stats_start_us = 0;
+
+//execution time of the tasks which have run inside the running task
+static uint32_t scheduler_nested_us = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns the due task with the highest priority which is not
+//running, SCHEDULER_TASK_COUNT when no task is due
+static uint8_t scheduler_next_task(uint64_t now_ms) {
+    uint8_t next = SCHEDULER_TASK_COUNT;
+
+    for(uint8_t i = 0; i < SCHEDULER_TASK_COUNT; i++) {
+        if(scheduler_running[i]) {
+            continue;
+        }
+        if(scheduler_tasks[i].period_ms == SCHEDULER_PERIOD_RELEASE
+                ? !scheduler_released[i] : now_ms < scheduler_release_ms[i]) {
+            continue;
+        }
+        if(next == SCHEDULER_TASK_COUNT
+                || scheduler_tasks[i].priority < scheduler_tasks[next].priority) {
+            next = i;
+        }
+    }
+    return next;
+}
+
+//this function runs a task, sets its next release and measures it
+static void scheduler_execute(uint8_t task, uint64_t now_ms) {
+    const scheduler_task_t* entry = &scheduler_tasks[task];
+    scheduler_stats_t* stats = &scheduler_stats[task];
+
+    //the next release is counted from the last one, when the task is more
+    //than one period late the missed releases are skipped
+    if(entry->period_ms == SCHEDULER_PERIOD_RELEASE) {
+        scheduler_released[task] = false;
+    } else {
+        scheduler_release_ms[task] += entry->period_ms;
+        if(scheduler_release_ms[task] <= now_ms) {
+            stats->missed++;
+            scheduler_release_ms[task] = now_ms + entry->period_ms;
+        }
+    }
+
+    //the time of the tasks which run nested in this task belongs to them
+    uint32_t outer_nested_us = scheduler_nested_us;
+    scheduler_nested_us = 0;
+    scheduler_running[task] = true;
+
+    uint32_t start_us = systime_get_us();
+    entry->function();
+    uint32_t elapsed_us = systime_get_us() - start_us;
+
+    scheduler_running[task] = false;
+    uint32_t own_us = elapsed_us - scheduler_nested_us;
+    scheduler_nested_us = outer_nested_us + elapsed_us;
+
+    stats->runs++;
+    stats->last_us = own_us;
+    stats->total_us += own_us;
+    if(own_us > stats->max_us) {
+        stats->max_us = own_us;
+    }
+    if(own_us > entry->budget_us) {
+        stats->overruns++;
+    }
+}
+
+//this function calculates a share of the time since the reset of the
+//statistic in 1/100 percent
+static uint16_t scheduler_share(uint64_t busy_us) {
+    uint64_t elapsed_us = systime_get_us64() - scheduler_stats_start_us;
+
+    if(elapsed_us == 0) {
+        return 0;
+    }
+    uint64_t share = (busy_us * 10000ULL) / elapsed_us;
+    return (uint16_t)((share > 10000) ? 10000 : share);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function releases all tasks at the current time and resets the
+//statistic
+void scheduler_initialize(void) {
+    uint64_t now_ms = systime_get_ms64();
+
+    for(uint8_t i = 0; i < SCHEDULER_TASK_COUNT; i++) {
+        scheduler_release_ms[i] = now_ms;
+        scheduler_released[i] = false;
+        scheduler_running[i] = false;
+    }
+    scheduler_nested_us = 0;
+    scheduler_reset_stats();
+}
+
+//this function runs the task with the highest priority of all tasks which
+//are due. It runs at most one task and returns false when no task was due
+bool scheduler_run(void) {
+    uint64_t now_ms = systime_get_ms64();
+    uint8_t task = scheduler_next_task(now_ms);
+
+    if(task == SCHEDULER_TASK_COUNT) {
+        return false;
+    }
+    scheduler_execute(task, now_ms);
+    scheduler_nested_us = 0;
+    return true;
+}
+
+//this function runs all due tasks which are not running at the moment. It
+//can be called from a task which has to wait, so the other tasks go on
+void scheduler_yield(void) {
+    uint64_t now_ms = systime_get_ms64();
+    uint8_t task;
+
+    while((task = scheduler_next_task(now_ms)) != SCHEDULER_TASK_COUNT) {
+        scheduler_execute(task, now_ms);
+    }
+}
+
+//this function releases a task with the period SCHEDULER_PERIOD_RELEASE,
+//it runs once as soon as it is the due task with the highest priority
+void scheduler_release(uint8_t task) {
+    if(scheduler_released[task]) {
+        scheduler_stats[task].missed++;
+    }
+    scheduler_released[task] = true;
+}
+
+//this function returns the statistic of a task
+const scheduler_stats_t* scheduler_get_stats(uint8_t task) {
+    return &scheduler_stats[task];
+}
+
+//this function returns the share of the cpu time of a task since the reset
+//of the statistic in 1/100 percent
+uint16_t scheduler_get_task_load(uint8_t task) {
+    return scheduler_share(scheduler_stats[task].total_us);
+}
+
+//this function returns the share of the cpu time of all tasks together
+//since the reset of the statistic in 1/100 percent
+uint16_t scheduler_get_load(void) {
+    uint64_t busy_us = 0;
+
+    for(uint8_t i = 0; i < SCHEDULER_TASK_COUNT; i++) {
+        busy_us += scheduler_stats[i].total_us;
+    }
+    return scheduler_share(busy_us);
+}
+
+//this function resets the statistic of all tasks
+void scheduler_reset_stats(void) {
+    for(uint8_t i = 0; i < SCHEDULER_TASK_COUNT; i++) {
+        scheduler_stats[i].runs = 0;
+        scheduler_stats[i].overruns = 0;
+        scheduler_stats[i].missed = 0;
+        scheduler_stats[i].last_us = 0;
+        scheduler_stats[i].max_us = 0;
+        scheduler_stats[i].total_us = 0;
+    }
+    scheduler_stats_start_us = systime_get_us64();
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/** scheduler
+
+  @Company
+    Schindelar
+
+  @File Name
+    scheduler.h
+
+  @Summary
+    Cooperative fixed rate scheduler of the main loop, every task runs to
+    its end and is measured against its budget
+ */
+/* ************************************************************************** */
+
+#ifndef _SCHEDULER_H    /* Guard against multiple inclusion */
+#define _SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//the tasks of the main loop, the table with their functions is declared in
+//main.c in the same order
+#define SCHEDULER_TASK_FLIGHT_CONTROLLER 0  //output to the flight controller
+#define SCHEDULER_TASK_GPS 1                //decoding of the gps sentences
+#define SCHEDULER_TASK_NAVIGATION 2         //flight process
+#define SCHEDULER_TASK_TIMER 3              //software timers
+#define SCHEDULER_TASK_BLUETOOTH 4          //lines from the bluetooth modul
+#define SCHEDULER_TASK_LOAD_CELL 5          //weight of the payload
+#define SCHEDULER_TASK_LOGGING 6            //status messages to the user
+#define SCHEDULER_TASK_FLASH 7              //hot start record in the flash
+#define SCHEDULER_TASK_COUNT 8
+
+//period of a task which is not released by the time but by
+//scheduler_release, for example with the control tick
+#define SCHEDULER_PERIOD_RELEASE 0
+
+//function of a task, it has to return after a short time
+typedef void (*scheduler_function_t)(void);
+
+//static declaration of a task
+typedef struct {
+    const char* name;           //short name for the report
+    scheduler_function_t function;
+    uint16_t period_ms;         //time between two releases of the task,
+                                //at least 1 ms or SCHEDULER_PERIOD_RELEASE
+    uint8_t priority;           //0 is the highest priority
+    uint16_t budget_us;         //longest allowed execution time
+} scheduler_task_t;
+
+//measurement of a task since the last reset of the statistic
+typedef struct {
+    uint32_t runs;              //amount of executions
+    uint32_t overruns;          //executions which were longer than the budget
+    uint32_t missed;            //releases which were skipped because the
+                                //task was later than one period or was
+                                //released again before it had run
+    uint32_t last_us;           //execution time of the last run
+    uint32_t max_us;            //longest execution time
+    uint64_t total_us;          //sum of all execution times
+} scheduler_stats_t;
+
+//table of the tasks, it is declared in main.c
+extern const scheduler_task_t scheduler_tasks[SCHEDULER_TASK_COUNT];
+
+//this function releases all tasks at the current time and resets the
+//statistic
+void scheduler_initialize(void);
+
+//this function runs the task with the highest priority of all tasks which
+//are due. It runs at most one task and returns false when no task was due
+bool scheduler_run(void);
+
+//this function runs all due tasks which are not running at the moment. It
+//can be called from a task which has to wait, so the other tasks go on
+void scheduler_yield(void);
+
+//this function releases a task with the period SCHEDULER_PERIOD_RELEASE,
+//it runs once as soon as it is the due task with the highest priority
+void scheduler_release(uint8_t task);
+
+//this function returns the statistic of a task
+const scheduler_stats_t* scheduler_get_stats(uint8_t task);
+
+//this function returns the share of the cpu time of a task since the reset
+//of the statistic in 1/100 percent
+uint16_t scheduler_get_task_load(uint8_t task);
+
+//this function returns the share of the cpu time of all tasks together
+//since the reset of the statistic in 1/100 percent
+uint16_t scheduler_get_load(void);
+
+//this function resets the statistic of all tasks
+void scheduler_reset_stats(void);
+
+#endif /* _SCHEDULER_H */
+
+/* *****************************************************************************
+ End of File
+ */
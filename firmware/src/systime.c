@@ -0,0 +1,333 @@
+/* ************************************************************************** */
+/** systime
+
+  @Company
+    Schindelar
+
+  @File Name
+    systime.c
+
+  @Summary
+    Monotonic system time of the firmware based on the SysTick timer.
+    The PPS output of the gps modul is routed through the EIC and the event
+    system into a capture channel of TC2, so every second edge is latched in
+    hardware without interrupt jitter. With the captures the SysTick period
+    is trimmed to the measured cpu clock and the system time is connected to
+    the utc time of the gps modul.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "definitions.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//milliseconds of one day for the wrap of the utc time
+#define SYSTIME_DAY_MS 86400000UL
+
+//event channel between the EIC and TC2
+#define SYSTIME_PPS_CHANNEL 0
+
+//the sense of the EXTINT 0 to 7 is in CONFIG0
+#if SYSTIME_PPS_EXTINT > 7
+#error "SYSTIME_PPS_EXTINT has to be in EIC_CONFIG0"
+#endif
+
+//milliseconds since the start, counted in the SysTick interrupt
+static volatile uint32_t systime_ms = 0;
+
+//overflows of the milliseconds, it is the high word of the 64 bit time
+static volatile uint32_t systime_ms_high = 0;
+
+//measured cpu clock in Hz, it is the amount of TC2 ticks between two PPS
+static volatile uint32_t systime_frequency = CPU_CLOCK_FREQUENCY;
+
+//TC2 value and system time in microseconds at the last PPS edge
+static uint32_t systime_pps_capture = 0;
+static volatile uint32_t systime_pps_us = 0;
+static volatile uint32_t systime_pps_count = 0;
+
+//utc time of the day in milliseconds at the anchor in system microseconds,
+//the anchor moves forward with every PPS
+static volatile bool systime_utc_valid = false;
+static volatile uint32_t systime_utc_anchor_ms = 0;
+static volatile uint32_t systime_utc_anchor_us = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interrupt                                                         */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//the SysTick handler replaces the Dummy_Handler alias from interrupts.c
+void SysTick_Handler(void) {
+    systime_ms++;
+    if(systime_ms == 0) {
+        systime_ms_high++;
+    }
+}
+
+//the TC2 handler replaces the Dummy_Handler alias from interrupts.c, it is
+//called after the PPS edge has been captured in CC0
+void TC2_Handler(void) {
+    //the capture has latched the counter at the PPS edge, the interrupt
+    //latency does not matter
+    uint32_t capture = TC2_REGS->COUNT32.TC_CC[0];
+    TC2_REGS->COUNT32.TC_INTFLAG = TC_INTFLAG_MC0_Msk;
+
+    //read the counter and the system time at the same moment to know the
+    //system time of the edge
+    TC2_REGS->COUNT32.TC_CTRLBSET = TC_CTRLBSET_CMD_READSYNC;
+    while(TC2_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_CTRLB_Msk);
+    uint32_t count = TC2_REGS->COUNT32.TC_COUNT;
+    uint32_t now_us = systime_get_us();
+
+    uint32_t pps_us = now_us - (uint32_t)(((uint64_t)(count - capture)
+            * 1000000UL) / systime_frequency);
+
+    //only a period near one second is used for the cpu clock, a missing
+    //pulse or a glitch will be skipped. The new value is filtered
+    uint32_t period = capture - systime_pps_capture;
+    if(systime_pps_count > 0
+            && period > (CPU_CLOCK_FREQUENCY / 100) * 98
+            && period < (CPU_CLOCK_FREQUENCY / 100) * 102) {
+        int32_t error = (int32_t)(period - systime_frequency);
+        systime_frequency = (uint32_t)((int32_t)systime_frequency + error / 4);
+
+        //trim the SysTick period to one real millisecond, the new value is
+        //used after the next reload
+        SysTick->LOAD = (systime_frequency + 500) / 1000 - 1;
+    }
+
+    //the utc anchor moves to the new edge with the full seconds in between
+    if(systime_utc_valid) {
+        uint32_t seconds = (pps_us - systime_utc_anchor_us + 500000UL)
+                / 1000000UL;
+        systime_utc_anchor_ms = (systime_utc_anchor_ms + seconds * 1000UL)
+                % SYSTIME_DAY_MS;
+        systime_utc_anchor_us = pps_us;
+    }
+
+    systime_pps_capture = capture;
+    systime_pps_us = pps_us;
+    systime_pps_count++;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function routes the PPS pin over EIC and EVSYS to a time stamp capture
+//of TC2, which runs as 32 bit counter (TC2 with TC3) with the cpu clock
+static void systime_pps_initialize(void) {
+    //clocks of the EIC, the event system and TC2 with TC3, TC2 gets the cpu
+    //clock from generator 0
+    MCLK_REGS->MCLK_APBAMASK |= MCLK_APBAMASK_EIC_Msk;
+    MCLK_REGS->MCLK_APBCMASK |= MCLK_APBCMASK_EVSYS_Msk
+            | MCLK_APBCMASK_TC2_Msk | MCLK_APBCMASK_TC3_Msk;
+    GCLK_REGS->GCLK_PCHCTRL[TC2_GCLK_ID] = GCLK_PCHCTRL_GEN(0x0UL)
+            | GCLK_PCHCTRL_CHEN_Msk;
+    while((GCLK_REGS->GCLK_PCHCTRL[TC2_GCLK_ID] & GCLK_PCHCTRL_CHEN_Msk)
+            != GCLK_PCHCTRL_CHEN_Msk);
+
+    //the PPS pin is an input with the EIC function A
+    PORT_REGS->GROUP[0].PORT_PINCFG[SYSTIME_PPS_PIN] = PORT_PINCFG_PMUXEN_Msk
+            | PORT_PINCFG_INEN_Msk;
+#if (SYSTIME_PPS_PIN % 2) == 0
+    PORT_REGS->GROUP[0].PORT_PMUX[SYSTIME_PPS_PIN / 2] =
+            (PORT_REGS->GROUP[0].PORT_PMUX[SYSTIME_PPS_PIN / 2]
+            & ~PORT_PMUX_PMUXE_Msk) | PORT_PMUX_PMUXE(0x0U);
+#else
+    PORT_REGS->GROUP[0].PORT_PMUX[SYSTIME_PPS_PIN / 2] =
+            (PORT_REGS->GROUP[0].PORT_PMUX[SYSTIME_PPS_PIN / 2]
+            & ~PORT_PMUX_PMUXO_Msk) | PORT_PMUX_PMUXO(0x0U);
+#endif
+
+    //the EIC detects the rising edge asynchronously, so the event has no
+    //delay of a synchronisation clock. The EIC itself runs with ULP32K
+    EIC_REGS->EIC_CTRLA = EIC_CTRLA_CKSEL_CLK_ULP32K;
+    EIC_REGS->EIC_CONFIG0 |= (EIC_CONFIG0_SENSE0_RISE_Val
+            << (SYSTIME_PPS_EXTINT * 4));
+    EIC_REGS->EIC_ASYNCH |= (1UL << SYSTIME_PPS_EXTINT);
+    EIC_REGS->EIC_EVCTRL |= EIC_EVCTRL_EXTINTEO(1UL << SYSTIME_PPS_EXTINT);
+    EIC_REGS->EIC_CTRLA |= EIC_CTRLA_ENABLE_Msk;
+    while(EIC_REGS->EIC_SYNCBUSY & EIC_SYNCBUSY_ENABLE_Msk);
+
+    //asynchronous event channel from the EIC to TC2
+    EVSYS_REGS->EVSYS_CHANNEL[SYSTIME_PPS_CHANNEL] =
+            EVSYS_CHANNEL_EVGEN(EVENT_ID_GEN_EIC_EXTINT_0 + SYSTIME_PPS_EXTINT)
+            | EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+    EVSYS_REGS->EVSYS_USER[EVENT_ID_USER_TC2_EVU] =
+            EVSYS_USER_CHANNEL(SYSTIME_PPS_CHANNEL + 1);
+
+    //TC2 counts free running and stores the counter in CC0 at every event
+    TC2_REGS->COUNT32.TC_CTRLA = TC_CTRLA_SWRST_Msk;
+    while(TC2_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_SWRST_Msk);
+    TC2_REGS->COUNT32.TC_CTRLA = TC_CTRLA_MODE_COUNT32
+            | TC_CTRLA_PRESCALER_DIV1 | TC_CTRLA_CAPTEN0_Msk;
+    TC2_REGS->COUNT32.TC_EVCTRL = TC_EVCTRL_TCEI_Msk | TC_EVCTRL_EVACT_STAMP;
+    TC2_REGS->COUNT32.TC_INTFLAG = (uint8_t)TC_INTFLAG_Msk;
+    TC2_REGS->COUNT32.TC_INTENSET = TC_INTENSET_MC0_Msk;
+    TC2_REGS->COUNT32.TC_CTRLA |= TC_CTRLA_ENABLE_Msk;
+    while(TC2_REGS->COUNT32.TC_SYNCBUSY & TC_SYNCBUSY_ENABLE_Msk);
+
+    NVIC_SetPriority(TC2_IRQn, 3);
+    NVIC_EnableIRQ(TC2_IRQn);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function starts the SysTick timer with an interrupt every millisecond
+//and the capture of the PPS
+void systime_initialize(void) {
+    systime_ms = 0;
+    systime_ms_high = 0;
+    systime_frequency = CPU_CLOCK_FREQUENCY;
+    systime_pps_count = 0;
+    systime_utc_valid = false;
+    SysTick_Config(CPU_CLOCK_FREQUENCY / 1000);
+    systime_pps_initialize();
+}
+
+//this function returns the milliseconds since the start of the system
+//the value overflows after 49 days
+uint32_t systime_get_ms(void) {
+    return systime_ms;
+}
+
+//this function returns the microseconds since the start of the system, it
+//can also be called in an interrupt. The value overflows after 71 minutes,
+//so only the difference of two values should be used
+uint32_t systime_get_us(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t ms = systime_ms;
+    uint32_t ticks = SysTick->VAL;
+    uint32_t load = SysTick->LOAD;
+
+    //the SysTick counts down, when it has reloaded but the interrupt could
+    //not run yet (in an interrupt with the same priority) the millisecond
+    //is not counted yet
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && ticks > (load / 2)) {
+        ms++;
+    }
+
+    __set_PRIMASK(primask);
+
+    //the period is trimmed with the PPS, so it is not always the nominal
+    //cpu clock
+    return ms * 1000UL + ((load - ticks) * 1000UL) / (load + 1);
+}
+
+//this function returns the milliseconds since the start of the system as
+//64 bit value, it does not overflow
+uint64_t systime_get_ms64(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint64_t ms = ((uint64_t)systime_ms_high << 32) | systime_ms;
+
+    __set_PRIMASK(primask);
+
+    return ms;
+}
+
+//this function returns the microseconds since the start of the system as
+//64 bit value, it does not overflow and can also be called in an interrupt
+uint64_t systime_get_us64(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint64_t ms = ((uint64_t)systime_ms_high << 32) | systime_ms;
+    uint32_t ticks = SysTick->VAL;
+    uint32_t load = SysTick->LOAD;
+
+    //the same correction of a pending SysTick as in systime_get_us
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && ticks > (load / 2)) {
+        ms++;
+    }
+
+    __set_PRIMASK(primask);
+
+    return ms * 1000ULL + ((load - ticks) * 1000UL) / (load + 1);
+}
+
+//this function connects the system time to the utc time of the gps modul.
+//It is called with the utc time of the day of a sentence and the receive
+//time of the sentence. Only a sentence of a full second which has arrived
+//within one second after a PPS edge is used, it belongs to this edge
+void systime_set_utc(uint32_t utc_ms, uint32_t receive_us) {
+    //NAV-PVT times can be a few milliseconds beside the full second
+    uint32_t fraction = utc_ms % 1000;
+    if(fraction > 20 && fraction < 980) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t age = receive_us - systime_pps_us;
+    if(systime_pps_count > 0 && age < 1000000UL) {
+        systime_utc_anchor_ms = ((utc_ms + 500) / 1000 * 1000) % SYSTIME_DAY_MS;
+        systime_utc_anchor_us = systime_pps_us;
+        systime_utc_valid = true;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+//this function returns true when the last PPS edge is not older than two
+//seconds and the utc time of the edge is known
+bool systime_is_synchronised(void) {
+    return systime_utc_valid
+            && (systime_get_us() - systime_pps_us) < 2000000UL;
+}
+
+//this function changes a value of systime_get_us into the utc time of the
+//day in milliseconds, returns false when the utc time is not known yet
+bool systime_get_utc_ms(uint32_t us, uint32_t* utc_ms) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    bool valid = systime_utc_valid;
+    uint32_t anchor_ms = systime_utc_anchor_ms;
+    uint32_t anchor_us = systime_utc_anchor_us;
+
+    __set_PRIMASK(primask);
+
+    if(!valid) {
+        return false;
+    }
+
+    //the time can also be before the anchor
+    int32_t offset_ms = (int32_t)(us - anchor_us) / 1000;
+    *utc_ms = (uint32_t)((int32_t)anchor_ms + offset_ms + (int32_t)SYSTIME_DAY_MS)
+            % SYSTIME_DAY_MS;
+    return true;
+}
+
+//this function returns the cpu clock in Hz which was measured with the PPS
+uint32_t systime_get_frequency(void) {
+    return systime_frequency;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/** systime
+
+  @Company
+    Schindelar
+
+  @File Name
+    systime.h
+
+  @Summary
+    Monotonic system time of the firmware based on the SysTick timer,
+    disciplined with the PPS of the gps modul
+ */
+/* ************************************************************************** */
+
+#ifndef _SYSTIME_H    /* Guard against multiple inclusion */
+#define _SYSTIME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//pin of the PPS output of the gps modul, PA22 has the function EXTINT6
+#define SYSTIME_PPS_PIN 22
+#define SYSTIME_PPS_EXTINT 6
+
+//this function starts the SysTick timer with an interrupt every millisecond
+//and the capture of the PPS
+void systime_initialize(void);
+
+//this function returns the milliseconds since the start of the system
+//the value overflows after 49 days
+uint32_t systime_get_ms(void);
+
+//this function returns the microseconds since the start of the system, it
+//can also be called in an interrupt. The value overflows after 71 minutes,
+//so only the difference of two values should be used
+uint32_t systime_get_us(void);
+
+//this function returns the milliseconds since the start of the system as
+//64 bit value, it does not overflow
+uint64_t systime_get_ms64(void);
+
+//this function returns the microseconds since the start of the system as
+//64 bit value, it does not overflow and can also be called in an interrupt
+uint64_t systime_get_us64(void);
+
+//this function connects the system time to the utc time of the gps modul.
+//It is called with the utc time of the day of a sentence and the receive
+//time of the sentence. Only a sentence of a full second which has arrived
+//within one second after a PPS edge is used, it belongs to this edge
+void systime_set_utc(uint32_t utc_ms, uint32_t receive_us);
+
+//this function returns true when the last PPS edge is not older than two
+//seconds and the utc time of the edge is known
+bool systime_is_synchronised(void);
+
+//this function changes a value of systime_get_us into the utc time of the
+//day in milliseconds, returns false when the utc time is not known yet
+bool systime_get_utc_ms(uint32_t us, uint32_t* utc_ms);
+
+//this function returns the cpu clock in Hz which was measured with the PPS
+uint32_t systime_get_frequency(void);
+
+#endif /* _SYSTIME_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,149 @@
+/* ************************************************************************** */
+/** timer
+
+  @Company
+    Schindelar
+
+  @File Name
+    timer.c
+
+  @Summary
+    One shot and periodic software timers. Every timer has a deadline in
+    milliseconds of the 64 bit system time, so a timer can not overflow and a
+    periodic timer does not drift because the next deadline is counted from
+    the last one and not from the moment it was polled. The main loop polls
+    the timers, so the firmware keeps decoding the gps and answering the
+    uarts while a timer runs.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stddef.h>
+#include "timer.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//one entry of the timer table
+typedef struct {
+    uint64_t deadline_ms;       //system time in ms when the timer runs out
+    uint32_t period_ms;         //period of a periodic timer
+    bool running;
+    bool periodic;
+    bool expired;               //set when the timer has run out, it is
+                                //cleared by timer_expired
+    timer_callback_t callback;
+} timer_entry_t;
+
+static timer_entry_t timer_table[TIMER_COUNT];
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function checks if the timer has run out and starts a periodic timer
+//again, returns true when the timer has run out
+static bool timer_check(timer_entry_t* entry, uint64_t now_ms) {
+    if(!entry->running || now_ms < entry->deadline_ms) {
+        return false;
+    }
+
+    if(entry->periodic) {
+        //the next deadline is counted from the last one, a period which was
+        //missed completely is skipped
+        entry->deadline_ms += entry->period_ms;
+        if(entry->deadline_ms <= now_ms) {
+            entry->deadline_ms = now_ms + entry->period_ms;
+        }
+    } else {
+        entry->running = false;
+    }
+    entry->expired = true;
+    return true;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function starts a timer, it runs out after the period in milliseconds.
+//A periodic timer is started again with the same period, the callback can
+//be NULL when the timer is only checked with timer_expired
+void timer_start(uint8_t timer, uint32_t period_ms, bool periodic,
+        timer_callback_t callback) {
+    timer_entry_t* entry = &timer_table[timer];
+
+    entry->deadline_ms = systime_get_ms64() + period_ms;
+    entry->period_ms = (period_ms == 0 && periodic) ? 1 : period_ms;
+    entry->periodic = periodic;
+    entry->expired = false;
+    entry->callback = callback;
+    entry->running = true;
+}
+
+//this function stops a timer and forgets that it has run out
+void timer_stop(uint8_t timer) {
+    timer_table[timer].running = false;
+    timer_table[timer].expired = false;
+}
+
+//this function returns true while the timer is running
+bool timer_is_running(uint8_t timer) {
+    return timer_table[timer].running;
+}
+
+//this function returns true once after the timer has run out, a periodic
+//timer counts as run out once for every period. The timer is only checked
+//in timer_update, so the callback of the timer is always called there
+bool timer_expired(uint8_t timer) {
+    timer_entry_t* entry = &timer_table[timer];
+
+    if(!entry->expired) {
+        return false;
+    }
+    entry->expired = false;
+    return true;
+}
+
+//this function returns the milliseconds until the timer runs out, 0 when it
+//is not running
+uint32_t timer_remaining_ms(uint8_t timer) {
+    uint64_t now_ms = systime_get_ms64();
+
+    if(!timer_table[timer].running
+            || now_ms >= timer_table[timer].deadline_ms) {
+        return 0;
+    }
+    return (uint32_t)(timer_table[timer].deadline_ms - now_ms);
+}
+
+//this function checks all timers against the system time and calls the
+//callbacks of the timers which have run out. It does not block and has to
+//be called regularly from the main loop
+void timer_update(void) {
+    uint64_t now_ms = systime_get_ms64();
+
+    for(uint8_t i = 0; i < TIMER_COUNT; i++) {
+        timer_entry_t* entry = &timer_table[i];
+        if(timer_check(entry, now_ms) && entry->callback != NULL) {
+            entry->callback();
+        }
+    }
+}
+
+/* *****************************************************************************
+ End of File
+ */
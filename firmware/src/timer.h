@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/** timer
+
+  @Company
+    Schindelar
+
+  @File Name
+    timer.h
+
+  @Summary
+    One shot and periodic software timers on the 64 bit system time, they
+    are polled from the main loop instead of waiting in a delay
+ */
+/* ************************************************************************** */
+
+#ifndef _TIMER_H    /* Guard against multiple inclusion */
+#define _TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//the software timers of the firmware
+#define TIMER_STATE 0           //waits of the states of the flight process
+#define TIMER_OVERWEIGHT 1      //repeat of the overweight message
+#define TIMER_COMMAND_REFRESH 2 //repeat of the flight controller command
+#define TIMER_COUNT 3
+
+//function which is called from timer_update when a timer has run out
+typedef void (*timer_callback_t)(void);
+
+//this function starts a timer, it runs out after the period in milliseconds.
+//A periodic timer is started again with the same period, the callback can
+//be NULL when the timer is only checked with timer_expired
+void timer_start(uint8_t timer, uint32_t period_ms, bool periodic,
+        timer_callback_t callback);
+
+//this function stops a timer and forgets that it has run out
+void timer_stop(uint8_t timer);
+
+//this function returns true while the timer is running
+bool timer_is_running(uint8_t timer);
+
+//this function returns true once after the timer has run out, a periodic
+//timer counts as run out once for every period. The timer is only checked
+//in timer_update, so the callback of the timer is always called there
+bool timer_expired(uint8_t timer);
+
+//this function returns the milliseconds until the timer runs out, 0 when it
+//is not running
+uint32_t timer_remaining_ms(uint8_t timer);
+
+//this function checks all timers against the system time and calls the
+//callbacks of the timers which have run out. It does not block and has to
+//be called regularly from the main loop
+void timer_update(void);
+
+#endif /* _TIMER_H */
+
+/* *****************************************************************************
+ End of File
+ */
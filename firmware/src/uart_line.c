@@ -0,0 +1,211 @@
+/* ************************************************************************** */
+/** uart_line
+
+  @Company
+    Schindelar
+
+  @File Name
+    uart_line.c
+
+  @Summary
+    Interrupt driven line receiver for the bluetooth modul at SERCOM2 and the
+    flight controller at SERCOM1. Every received byte is handled in the
+    receive interrupt and the stream is split at "\r" or "\n" into lines in a
+    small pool of line buffers. The first character and the line ending are
+    stamped with the microsecond time, so the latency of a message can be
+    measured. The main loop picks up the finished lines without blocking.
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <string.h>
+#include "definitions.h"
+#include "uart_line.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//line receiver of one uart
+typedef struct {
+    //pool of line buffers with their receive times, the receive interrupt
+    //writes at the write index and the main loop reads at the read index
+    char line[UART_LINE_COUNT][UART_LINE_LENGTH];
+    uart_line_time_t time[UART_LINE_COUNT];
+
+    //both indices are running free, the slot is the index masked with the
+    //UART_LINE_COUNT
+    volatile uint8_t write_index;
+    volatile uint8_t read_index;
+
+    //state of the line which is assembled at the moment, dropped is true
+    //while the bytes of a dropped line are coming in
+    uint8_t length;
+    bool active;
+    bool dropped;
+
+    //the plib reads every byte into this variable
+    uint8_t receive_byte;
+
+    //counter of all lost lines
+    volatile uint32_t lost_lines;
+
+    //plib functions of the uart
+    bool (*read)(void* buffer, const size_t size);
+    USART_ERROR (*error_get)(void);
+} uart_line_receiver_t;
+
+static uart_line_receiver_t uart_line_receiver[UART_LINE_CHANNELS] = {
+    {.read = SERCOM2_USART_Read, .error_get = SERCOM2_USART_ErrorGet},
+    {.read = SERCOM1_USART_Read, .error_get = SERCOM1_USART_ErrorGet},
+};
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Receive interrupt                                                 */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function is called for every received byte and assembles the lines
+static void uart_line_handle_byte(uart_line_receiver_t* receiver,
+        uint8_t data) {
+    uint8_t slot = receiver->write_index & (UART_LINE_COUNT - 1);
+
+    //the line ending finishes the line and gives it to the main loop, empty
+    //lines like the "\n" after a "\r" will be ignored
+    if(data == '\r' || data == '\n') {
+        receiver->dropped = false;
+        if(!receiver->active) {
+            return;
+        }
+        receiver->line[slot][receiver->length] = '\0';
+        receiver->time[slot].end_us = systime_get_us();
+        receiver->active = false;
+
+        //the line has to be written completely before the index changes
+        __DMB();
+        receiver->write_index++;
+        return;
+    }
+
+    //the rest of a dropped line will be ignored until the line ending
+    if(receiver->dropped) {
+        return;
+    }
+
+    //the first character starts a new line
+    if(!receiver->active) {
+        //when all line buffers are full the new line has to be dropped
+        if((uint8_t)(receiver->write_index - receiver->read_index)
+                >= UART_LINE_COUNT) {
+            receiver->dropped = true;
+            receiver->lost_lines++;
+            return;
+        }
+        receiver->time[slot].start_us = systime_get_us();
+        receiver->length = 0;
+        receiver->active = true;
+    }
+
+    //a line which is too long will be dropped
+    if(receiver->length >= (UART_LINE_LENGTH - 1)) {
+        receiver->active = false;
+        receiver->dropped = true;
+        receiver->lost_lines++;
+        return;
+    }
+
+    receiver->line[slot][receiver->length++] = (char)data;
+}
+
+//this callback is called by the plib from the SERCOM2 and SERCOM1 interrupt
+//after every received byte or after an uart error, the context is the
+//receiver of the uart
+static void uart_line_receive_callback(uintptr_t context) {
+    uart_line_receiver_t* receiver = (uart_line_receiver_t*)context;
+
+    if(receiver->error_get() != USART_ERROR_NONE) {
+        //the byte is broken so the current line is lost
+        if(receiver->active) {
+            receiver->active = false;
+            receiver->dropped = true;
+            receiver->lost_lines++;
+        }
+    } else {
+        uart_line_handle_byte(receiver, receiver->receive_byte);
+    }
+
+    //start the read of the next byte directly in the interrupt, so no
+    //byte gets lost between two reads
+    receiver->read(&receiver->receive_byte, 1);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function starts the continous receiving at SERCOM2 and SERCOM1, after
+//this every incoming byte will be handled in the receive interrupt
+void uart_line_initialize(void) {
+    for(uint8_t i = 0; i < UART_LINE_CHANNELS; i++) {
+        uart_line_receiver_t* receiver = &uart_line_receiver[i];
+        receiver->write_index = 0;
+        receiver->read_index = 0;
+        receiver->length = 0;
+        receiver->active = false;
+        receiver->dropped = false;
+        receiver->lost_lines = 0;
+    }
+
+    SERCOM2_USART_ReadCallbackRegister(uart_line_receive_callback,
+            (uintptr_t)&uart_line_receiver[UART_LINE_BLUETOOTH]);
+    SERCOM1_USART_ReadCallbackRegister(uart_line_receive_callback,
+            (uintptr_t)&uart_line_receiver[UART_LINE_FLIGHT_CONTROLLER]);
+
+    for(uint8_t i = 0; i < UART_LINE_CHANNELS; i++) {
+        uart_line_receiver[i].read(&uart_line_receiver[i].receive_byte, 1);
+    }
+}
+
+//this function copies the oldest complete line of the uart without the line
+//ending into the buffer and gives the line back to the receive interrupt.
+//The receive time is written into time when it is not NULL.
+//returns false when there is no complete line
+bool uart_line_read(uint8_t channel, uint8_t* buffer, uint16_t size,
+        uart_line_time_t* time) {
+    uart_line_receiver_t* receiver = &uart_line_receiver[channel];
+    uint8_t slot = receiver->read_index & (UART_LINE_COUNT - 1);
+
+    if(receiver->read_index == receiver->write_index) {
+        return false;
+    }
+
+    strncpy((char*)buffer, receiver->line[slot], size - 1);
+    buffer[size - 1] = '\0';
+    if(time != NULL) {
+        *time = receiver->time[slot];
+    }
+
+    receiver->read_index++;
+    return true;
+}
+
+//this function returns the amount of lines which were lost because the
+//pool was full, a line was too long or the uart had an error
+uint32_t uart_line_get_lost_lines(uint8_t channel) {
+    return uart_line_receiver[channel].lost_lines;
+}
+
+/* *****************************************************************************
+ End of File
+ */
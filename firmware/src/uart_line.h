@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/** uart_line
+
+  @Company
+    Schindelar
+
+  @File Name
+    uart_line.h
+
+  @Summary
+    Interrupt driven line receiver with receive timestamps for the bluetooth
+    modul at SERCOM2 and the flight controller at SERCOM1
+ */
+/* ************************************************************************** */
+
+#ifndef _UART_LINE_H    /* Guard against multiple inclusion */
+#define _UART_LINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//the uarts with a line receiver. The flight controller at SERCOM1 runs with
+//115200 Baud 8N1 like the bluetooth modul, this is set in the MCC
+//configuration of SERCOM1. A command like "1500 1750 1500 1250\n" has 20
+//characters of 10 bits, it takes 1.7 ms and fits into one control tick up
+//to 500 Hz
+#define UART_LINE_BLUETOOTH 0           //SERCOM2
+#define UART_LINE_FLIGHT_CONTROLLER 1   //SERCOM1
+#define UART_LINE_CHANNELS 2
+
+//amount of line buffers of every uart, has to be a power of two because the
+//read and write index are running free and will be masked
+#define UART_LINE_COUNT 2
+
+//maximum length of one line with the terminating 0
+#define UART_LINE_LENGTH 100
+
+//receive time of one line, both values are from systime_get_us
+typedef struct {
+    uint32_t start_us;      //time of the first character of the line
+    uint32_t end_us;        //time of the line ending
+} uart_line_time_t;
+
+//this function starts the continous receiving at SERCOM2 and SERCOM1, after
+//this every incoming byte will be handled in the receive interrupt
+void uart_line_initialize(void);
+
+//this function copies the oldest complete line of the uart without the line
+//ending into the buffer and gives the line back to the receive interrupt.
+//The receive time is written into time when it is not NULL.
+//returns false when there is no complete line
+bool uart_line_read(uint8_t channel, uint8_t* buffer, uint16_t size,
+        uart_line_time_t* time);
+
+//this function returns the amount of lines which were lost because the
+//pool was full, a line was too long or the uart had an error
+uint32_t uart_line_get_lost_lines(uint8_t channel);
+
+#endif /* _UART_LINE_H */
+
+/* *****************************************************************************
+ End of File
+ */
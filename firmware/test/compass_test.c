@@ -0,0 +1,227 @@
+/* ************************************************************************** */
+/** compass_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    compass_test.c
+
+  @Summary
+    Host check of the integer compass_direction against the old double
+    compass_direction with pow() of the baseline. The old function takes the
+    linear mean of the azimuths, it is only right for satellites in a sector
+    which does not contain north, so it is compared on such groups. On all
+    groups with a clear direction the same pow() weights are checked with
+    the mean of the unit vectors. The wrap of the declination is checked
+    with single satellites around north
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "compass.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of random groups of satellites
+#define TEST_GROUPS 100000
+
+//allowed error in degrees
+#define TEST_LIMIT 0.5
+
+//width of the sector in degrees for the comparison with the old function
+#define TEST_SECTOR 40
+
+//groups with a mean vector shorter than this share of the summed power
+//have no clear direction and are not checked
+#define TEST_MIN_RESULTANT 0.2
+
+//the declination of the old function in degrees
+#define magnetic_declination (COMPASS_DECLINATION / 100.0)
+
+//state of the random generator, the corpus is the same in every run
+static uint32_t test_random_state = 0x12345678UL;
+
+static int test_errors = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns a random number from 0 to range - 1
+static uint32_t test_random(uint32_t range) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return test_random_state % range;
+}
+
+//the old function of flugprotokoll.c, only the table is read instead of the
+//single_satelite_data array
+static double old_compass_direction(const gps_satellite_table_t* satelites) {
+    double full_aszi = 0;
+    double full_signal = 0;
+    int used_satelites = 0;
+    for(int i = 0; i < satelites->count; i++) {
+        if(satelites->satellite[i].signal_strength >= 10) {
+            full_aszi += satelites->satellite[i].azimuth * pow(10,
+                    satelites->satellite[i].signal_strength / 10.0);
+            full_signal += pow(10, satelites->satellite[i].signal_strength / 10.0);
+            used_satelites++;
+        }
+    }
+
+    if(used_satelites == 0)
+        return -1;
+
+    double azimuth = full_aszi / full_signal;
+    azimuth = fmod(azimuth+360, 360); //change the azimuth range to 0 to 360
+    azimuth += magnetic_declination; //for the HTL add the magnetic declination
+    azimuth = fmod(azimuth+360, 360); //change the azimuth range to 0 to 360
+
+    return azimuth;
+}
+
+//the pow() weights of the old function with the mean of the unit vectors,
+//the length of the mean vector relative to the summed power is returned too
+static double vector_compass_direction(const gps_satellite_table_t* satellites,
+        double* resultant) {
+    double north = 0;
+    double east = 0;
+    double power = 0;
+
+    for(int i = 0; i < satellites->count; i++) {
+        const gps_satellite_t* satellite = &satellites->satellite[i];
+        if(satellite->signal_strength >= COMPASS_MIN_SIGNAL) {
+            double weight = pow(10, satellite->signal_strength / 10.0);
+            north += weight * cos(satellite->azimuth * M_PI / 180);
+            east += weight * sin(satellite->azimuth * M_PI / 180);
+            power += weight;
+        }
+    }
+    *resultant = sqrt(north * north + east * east) / power;
+    double azimuth = atan2(east, north) * 180 / M_PI + magnetic_declination;
+    return fmod(azimuth + 720, 360);
+}
+
+//this function returns the difference of two angles in degrees between 0
+//and 180
+static double test_angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+//this function builds a random group of 4 to 12 satellites with azimuths
+//from first to first + width degrees
+static void test_build_group(gps_satellite_table_t* satellites,
+        uint16_t first, uint16_t width) {
+    satellites->count = (uint8_t)(4 + test_random(9));
+    for(uint8_t i = 0; i < satellites->count; i++) {
+        satellites->satellite[i].azimuth = (uint16_t)((first
+                + test_random(width + 1U)) % 360);
+        satellites->satellite[i].signal_strength = (int8_t)(10
+                + test_random(41));
+    }
+}
+
+//this function checks one satellite, the direction is its azimuth with the
+//declination within the 0.1 degrees of the CORDIC tier and always inside 0
+//to 35999
+static void test_single(uint16_t azimuth, int32_t expected) {
+    gps_satellite_table_t satellites = {0};
+
+    satellites.count = 1;
+    satellites.satellite[0].azimuth = azimuth;
+    satellites.satellite[0].signal_strength = 40;
+    int32_t direction = compass_direction(&satellites);
+    if(direction < 0 || direction >= 36000
+            || test_angle_error(direction / 100.0, expected / 100.0) > 0.1) {
+        printf("FAIL azimuth %u gives %ld instead of %ld\n", azimuth,
+                (long)direction, (long)expected);
+        test_errors++;
+    }
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    gps_satellite_table_t satellites = {0};
+    double max_old_error = 0;
+    double max_vector_error = 0;
+    int vector_groups = 0;
+
+    //groups in a sector without north against the old function
+    for(int i = 0; i < TEST_GROUPS; i++) {
+        uint16_t first = (uint16_t)test_random(360 - TEST_SECTOR);
+        test_build_group(&satellites, first, TEST_SECTOR);
+        double error = test_angle_error(compass_direction(&satellites) / 100.0,
+                old_compass_direction(&satellites));
+        if(error > max_old_error) {
+            max_old_error = error;
+        }
+    }
+
+    //groups with every spread around the whole circle against the mean of
+    //the unit vectors
+    for(int i = 0; i < TEST_GROUPS; i++) {
+        test_build_group(&satellites, (uint16_t)test_random(360),
+                (uint16_t)test_random(360));
+        double resultant;
+        double expected = vector_compass_direction(&satellites, &resultant);
+        if(resultant < TEST_MIN_RESULTANT) {
+            continue;
+        }
+        double error = test_angle_error(compass_direction(&satellites) / 100.0,
+                expected);
+        if(error > max_vector_error) {
+            max_vector_error = error;
+        }
+        vector_groups++;
+    }
+
+    if(max_old_error > TEST_LIMIT || max_vector_error > TEST_LIMIT) {
+        printf("FAIL direction error above %.1f degrees\n", TEST_LIMIT);
+        test_errors++;
+    }
+
+    //the declination is wrapped into 0 to 35999 for both signs
+    test_single(0, (COMPASS_DECLINATION + 36000) % 36000);
+    test_single(359, (35900 + COMPASS_DECLINATION + 36000) % 36000);
+    test_single(180, 18000 + COMPASS_DECLINATION);
+
+    //no satellite with a strong enough signal
+    satellites.count = 1;
+    satellites.satellite[0].signal_strength = COMPASS_MIN_SIGNAL - 1;
+    if(compass_direction(&satellites) != -1) {
+        printf("FAIL weak satellite used\n");
+        test_errors++;
+    }
+
+    printf("compass %+d cdeg: %d errors\n", COMPASS_DECLINATION, test_errors);
+    printf("compass %+d cdeg: %.3f deg against the old function in %d degree "
+            "sectors, %.3f deg against the vector mean in %d groups\n",
+            COMPASS_DECLINATION, max_old_error, TEST_SECTOR, max_vector_error,
+            vector_groups);
+    return test_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/** divas_host
+
+  @Company
+    Schindelar
+
+  @File Name
+    divas_host.c
+
+  @Summary
+    Host version of the DIVAS functions for the host tests. The results are
+    the same as on the DIVAS: the quotient is rounded towards 0, a division
+    by 0 gives 0 and the square root is rounded down
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include "divas_math.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Interface Functions                                               */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//there is no DIVAS on the host
+void divas_initialize(void) {
+}
+
+//this function divides two signed numbers, the result is rounded towards 0
+//and it is 0 when the divisor is 0
+int32_t divas_divide(int32_t dividend, int32_t divisor) {
+    if(divisor == 0 || (dividend == INT32_MIN && divisor == -1)) {
+        return divisor == 0 ? 0 : INT32_MIN;
+    }
+    return dividend / divisor;
+}
+
+//this function divides two unsigned numbers, the result is rounded down and
+//it is 0 when the divisor is 0
+uint32_t divas_udivide(uint32_t dividend, uint32_t divisor) {
+    return divisor == 0 ? 0 : dividend / divisor;
+}
+
+//this function calculates the square root of an unsigned number, the result
+//is rounded down
+uint32_t divas_sqrt(uint32_t value) {
+    uint32_t root = 0;
+
+    for(uint32_t bit = 1UL << 15; bit != 0; bit >>= 1) {
+        uint32_t trial = root | bit;
+        if(trial * trial <= value) {
+            root = trial;
+        }
+    }
+    return root;
+}
+
+/* *****************************************************************************
+ End of File
+ */
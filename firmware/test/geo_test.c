@@ -0,0 +1,406 @@
+/* ************************************************************************** */
+/** geo_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    geo_test.c
+
+  @Summary
+    Host check of the integer geodesy against the double distance() and
+    courseTO() which the flight process used before the geo module. Random
+    legs up to 10 km between the latitudes -70 and 70 degrees are checked
+    against the accuracy written in geo.h, the distance against the exact
+    equirectangular distance, because the old distance() calculated with
+    0.01745 for one degree in radians. The frame of the legs is checked
+    against geo_north, geo_east and the exact projection of a fix onto the
+    leg, the sign of the cross track error on legs to the north, east, south
+    and west and the leg without length
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "geo.h"
+#include "host_timing.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of random legs
+#define TEST_LEGS 200000
+
+//amount of legs the fixes of the timing are spread over
+#define TEST_TIMING_LEGS 256
+
+//the constants of the old functions
+#define TWO_PI 2*M_PI
+#define latitude_distance 111.19494
+#define one_degree_in_radians 0.01745
+
+//state of the random generator, the corpus is the same in every run
+static uint64_t test_random_state = 0x9E3779B97F4A7C15ULL;
+
+//the result is written here, so the compiler can not remove the work
+static volatile double test_sink;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns a random number between 0 and 1
+static double test_random(void) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 7;
+    test_random_state ^= test_random_state << 17;
+    return (double)(test_random_state >> 11) / (double)(1ULL << 53);
+}
+
+//the old functions of flugprotokoll.c, unchanged
+static double radians_to_degrees(double rad) {
+    return (rad * 180.0) / M_PI;
+}
+
+static double degrees_to_radians(double degrees) {
+    return ( degrees * M_PI) / 180;
+}
+
+static double distance(double start_lat, double start_lon, double end_lat,
+        double end_lon) {
+    double latitude_mean = (start_lat + end_lat) / 2 * one_degree_in_radians;
+    double dx = latitude_distance * cos(latitude_mean) * (start_lon - end_lon);
+    double dy = latitude_distance * (start_lat - end_lat);
+    double distance = (sqrt(dx * dx + dy * dy)) * 1000;
+
+    return distance;
+}
+
+static double courseTO(double lat1, double lon1, double lat2, double lon2) {
+    double dlon = degrees_to_radians(lon2-lon1);
+    lat1 = degrees_to_radians(lat1);
+    lat2 = degrees_to_radians(lat2);
+    double tangency = sin(dlon) * cos(lat2);
+    double partial = sin(lat1) * cos(lat2) * cos(dlon);
+    partial = cos(lat1) * sin(lat2) - partial;
+    double direction_radiant = atan2(tangency, partial);
+    if(direction_radiant < 0.0) {
+        direction_radiant += TWO_PI;
+    }
+    return radians_to_degrees(direction_radiant);
+}
+
+//the old distance() with the exact radians of one degree
+static double exact_distance(double start_lat, double start_lon,
+        double end_lat, double end_lon) {
+    double latitude_mean = degrees_to_radians((start_lat + end_lat) / 2);
+    double dx = latitude_distance * cos(latitude_mean) * (start_lon - end_lon);
+    double dy = latitude_distance * (start_lat - end_lat);
+    return sqrt(dx * dx + dy * dy) * 1000;
+}
+
+//this function returns the difference of two angles in degrees between 0
+//and 180
+static double test_angle_error(double a, double b) {
+    double error = fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+    return error;
+}
+
+//this function changes a difference in 1e-7 degrees into exact centimetres
+//of the equirectangular projection, the longitude with the cos of the mean
+//latitude of the leg
+static void test_exact_frame(int32_t delta_latitude, int32_t delta_longitude,
+        double mean_latitude, double* north, double* east) {
+    double cm_per_e7 = latitude_distance * 1e5 * 1e-7;
+    *north = delta_latitude * cm_per_e7;
+    *east = delta_longitude * cm_per_e7
+            * cos(degrees_to_radians(mean_latitude));
+}
+
+//this function checks the frame of the legs of the corpus. The end of the
+//leg has to be the same as with geo_north and geo_east, the way along the
+//leg and the cross track error of a fix up to 10 km away have to be within
+//0.02 % of its distance + 3 cm of the exact projection onto the leg. The
+//function returns the amount of errors and the largest error in cm above
+//0.02 %
+static int test_leg_frame(int32_t (*corpus)[4], int legs,
+        double* max_track_error) {
+    int errors = 0;
+    *max_track_error = 0;
+
+    for(int i = 0; i < legs; i++) {
+        geo_leg_t leg;
+        geo_leg_initialize(&leg, corpus[i][0], corpus[i][1], corpus[i][2],
+                corpus[i][3]);
+        uint16_t cos_scale = geo_cos_scale(corpus[i][0] / 2
+                + corpus[i][2] / 2);
+        if(leg.target_north != geo_north(corpus[i][2] - corpus[i][0])
+                || leg.target_east != geo_east(corpus[i][3] - corpus[i][1],
+                cos_scale)) {
+            errors++;
+            continue;
+        }
+
+        //a fix with the offset of the next leg of the corpus
+        int next = (i + 1) % legs;
+        int32_t delta_latitude = corpus[next][2] - corpus[next][0];
+        int32_t delta_longitude = corpus[next][3] - corpus[next][1];
+        int32_t north, east, along, cross;
+        geo_leg_position(&leg, corpus[i][0] + delta_latitude,
+                corpus[i][1] + delta_longitude, &north, &east);
+        geo_leg_track(&leg, north, east, &along, &cross);
+
+        //short legs are not checked, the direction depends on the last
+        //digit of the position
+        double mean_latitude = (corpus[i][0] / 2 + corpus[i][2] / 2) / 1e7;
+        double target_north, target_east, fix_north, fix_east;
+        test_exact_frame(corpus[i][2] - corpus[i][0],
+                corpus[i][3] - corpus[i][1], mean_latitude, &target_north,
+                &target_east);
+        double length = hypot(target_north, target_east);
+        if(length < 10000) {
+            continue;
+        }
+        test_exact_frame(delta_latitude, delta_longitude, mean_latitude,
+                &fix_north, &fix_east);
+        double exact_along = (fix_north * target_north
+                + fix_east * target_east) / length;
+        double exact_cross = (fix_east * target_north
+                - fix_north * target_east) / length;
+
+        double limit = hypot(fix_north, fix_east) * 0.0002;
+        double error = fmax(fabs(along - exact_along),
+                fabs(cross - exact_cross)) - limit;
+        if(error > *max_track_error) {
+            *max_track_error = error;
+        }
+        if(error > 3.0) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+//this function checks the sign of the cross track error on legs of 1 km to
+//the north, east, south and west with a fix 100 m right of the middle, and
+//the leg without length, which points to the north. It returns the amount
+//of errors
+static int test_leg_sign(void) {
+    //1 km and 100 m in 1e-7 degrees at the latitude 0
+    const int32_t leg_e7 = 89933;
+    const int32_t side_e7 = 8993;
+    //the direction of the legs and of the right side as north and east
+    const int8_t directions[4][4] = {
+        {1, 0, 0, 1}, {0, 1, -1, 0}, {-1, 0, 0, -1}, {0, -1, 1, 0}
+    };
+    int errors = 0;
+
+    for(int i = 0; i < 4; i++) {
+        geo_leg_t leg;
+        int32_t north, east, along, cross;
+        geo_leg_initialize(&leg, 0, 0, directions[i][0] * leg_e7,
+                directions[i][1] * leg_e7);
+        geo_leg_position(&leg, directions[i][0] * leg_e7 / 2
+                + directions[i][2] * side_e7, directions[i][1] * leg_e7 / 2
+                + directions[i][3] * side_e7, &north, &east);
+        geo_leg_track(&leg, north, east, &along, &cross);
+        if(abs(along - 50000) > 5 || abs(cross - 10000) > 5
+                || leg.bearing != i * 9000) {
+            printf("FAIL leg %d: along %d cm cross %d cm bearing %u\n",
+                    i * 90, (int)along, (int)cross, leg.bearing);
+            errors++;
+        }
+    }
+
+    //the leg without length points to the north, so east is right
+    geo_leg_t leg;
+    int32_t north, east, along, cross;
+    geo_leg_initialize(&leg, 480739670, 162904615, 480739670, 162904615);
+    geo_leg_position(&leg, 480739670 + side_e7, 162904615 + side_e7,
+            &north, &east);
+    geo_leg_track(&leg, north, east, &along, &cross);
+    if(leg.length != 0 || leg.bearing != 0 || leg.unit_north != INT16_MAX
+            || leg.unit_east != 0 || geo_leg_distance(&leg, 0, 0) != 0
+            || abs(along - north) > 1 || abs(cross - east) > 1
+            || cross <= 0) {
+        printf("FAIL leg without length: along %d cm cross %d cm\n",
+                (int)along, (int)cross);
+        errors++;
+    }
+    return errors;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    double max_distance_error = 0;      //cm above 0.01 %
+    double max_old_distance_error = 0;  //percent against the old distance()
+    double max_bearing_error_2km = 0;   //degrees
+    double max_bearing_error_10km = 0;
+    int errors = 0;
+
+    static int32_t corpus[TEST_LEGS][4];
+    for(int i = 0; i < TEST_LEGS; i++) {
+        double latitude = -70.0 + 140.0 * test_random();
+        double longitude = -180.0 + 360.0 * test_random();
+        double length_m = 10000.0 * test_random();
+        double direction = TWO_PI * test_random();
+        double end_latitude = latitude + length_m * cos(direction)
+                / (latitude_distance * 1000);
+        double end_longitude = longitude + length_m * sin(direction)
+                / (latitude_distance * 1000
+                * cos(degrees_to_radians(latitude)));
+
+        corpus[i][0] = (int32_t)lround(latitude * 1e7);
+        corpus[i][1] = (int32_t)lround(longitude * 1e7);
+        corpus[i][2] = (int32_t)lround(end_latitude * 1e7);
+        corpus[i][3] = (int32_t)lround(end_longitude * 1e7);
+    }
+
+    for(int i = 0; i < TEST_LEGS; i++) {
+        double lat1 = corpus[i][0] / 1e7, lon1 = corpus[i][1] / 1e7;
+        double lat2 = corpus[i][2] / 1e7, lon2 = corpus[i][3] / 1e7;
+        uint16_t cos_scale = geo_cos_scale(corpus[i][0] / 2
+                + corpus[i][2] / 2);
+
+        double exact_cm = exact_distance(lat1, lon1, lat2, lon2) * 100;
+        double old_cm = distance(lat1, lon1, lat2, lon2) * 100;
+        double geo_cm = geo_distance(corpus[i][0], corpus[i][1],
+                corpus[i][2], corpus[i][3], cos_scale);
+
+        double error = fabs(geo_cm - exact_cm) - exact_cm * 0.0001;
+        if(error > max_distance_error) {
+            max_distance_error = error;
+        }
+        if(old_cm > 10000) {
+            double old_error = fabs(geo_cm - old_cm) / old_cm * 100;
+            if(old_error > max_old_distance_error) {
+                max_old_distance_error = old_error;
+            }
+        }
+
+        //the bearing of a very short leg depends on the last digit of the
+        //position and is not checked
+        if(exact_cm < 10000) {
+            continue;
+        }
+        double bearing = geo_bearing(corpus[i][0], corpus[i][1],
+                corpus[i][2], corpus[i][3], cos_scale) / 100.0;
+        double bearing_error = test_angle_error(bearing,
+                courseTO(lat1, lon1, lat2, lon2));
+        if(exact_cm <= 200000) {
+            if(bearing_error > max_bearing_error_2km) {
+                max_bearing_error_2km = bearing_error;
+            }
+        } else if(bearing_error > max_bearing_error_10km) {
+            max_bearing_error_10km = bearing_error;
+        }
+    }
+
+    //the limits of geo.h
+    if(max_distance_error > 3.0) {
+        printf("FAIL distance error above 0.01 %% + 3 cm\n");
+        errors++;
+    }
+    if(max_bearing_error_2km > 0.04 || max_bearing_error_10km > 0.13) {
+        printf("FAIL bearing error above the limit of geo.h\n");
+        errors++;
+    }
+
+    //the frame of the legs
+    double max_track_error;
+    int frame_errors = test_leg_frame(corpus, TEST_LEGS, &max_track_error);
+    if(frame_errors > 0) {
+        printf("FAIL %d legs with a frame away from geo_north and geo_east "
+                "or the exact projection\n", frame_errors);
+        errors++;
+    }
+    errors += test_leg_sign();
+
+    //timing of the old double functions against the integer path of one
+    //fix. The flight process builds the frame once for every leg and moves
+    //every fix into it, so the fixes are spread over TEST_TIMING_LEGS legs
+    //with the offsets of the corpus and the frame is timed on its own
+    static geo_leg_t legs[TEST_TIMING_LEGS];
+    static int32_t fixes[TEST_LEGS][2];
+    for(int i = 0; i < TEST_LEGS; i++) {
+        int leg = i % TEST_TIMING_LEGS;
+        fixes[i][0] = corpus[leg][0] + (corpus[i][2] - corpus[i][0]) / 2;
+        fixes[i][1] = corpus[leg][1] + (corpus[i][3] - corpus[i][1]) / 2;
+    }
+
+    uint64_t start = host_cycles();
+    for(int i = 0; i < TEST_LEGS; i++) {
+        int leg = i % TEST_TIMING_LEGS;
+        double lat1 = fixes[i][0] / 1e7, lon1 = fixes[i][1] / 1e7;
+        double lat2 = corpus[leg][2] / 1e7, lon2 = corpus[leg][3] / 1e7;
+        test_sink = distance(lat1, lon1, lat2, lon2)
+                + courseTO(lat1, lon1, lat2, lon2);
+    }
+    uint64_t old_cycles = host_cycles() - start;
+
+    start = host_cycles();
+    for(int i = 0; i < TEST_LEGS; i++) {
+        int leg = i % TEST_TIMING_LEGS;
+        geo_leg_initialize(&legs[leg], corpus[i][0], corpus[i][1],
+                corpus[i][2], corpus[i][3]);
+    }
+    uint64_t leg_cycles = host_cycles() - start;
+
+    //the last pass leaves the legs of the first TEST_TIMING_LEGS entries
+    for(int leg = 0; leg < TEST_TIMING_LEGS; leg++) {
+        geo_leg_initialize(&legs[leg], corpus[leg][0], corpus[leg][1],
+                corpus[leg][2], corpus[leg][3]);
+    }
+
+    start = host_cycles();
+    for(int i = 0; i < TEST_LEGS; i++) {
+        const geo_leg_t* leg = &legs[i % TEST_TIMING_LEGS];
+        int32_t north, east, along, cross;
+        geo_leg_position(leg, fixes[i][0], fixes[i][1], &north, &east);
+        uint32_t remaining = geo_leg_distance(leg, north, east);
+        geo_leg_track(leg, north, east, &along, &cross);
+        test_sink = remaining + along + cross;
+    }
+    uint64_t fix_cycles = host_cycles() - start;
+
+    printf("geo: %d legs up to 10 km, %d errors\n", TEST_LEGS, errors);
+    printf("geo: distance error %.2f cm above 0.01 %% of the exact "
+            "distance, %.3f %% against the old distance()\n",
+            max_distance_error < 0 ? 0 : max_distance_error,
+            max_old_distance_error);
+    printf("geo: bearing error %.3f deg up to 2 km, %.3f deg up to 10 km "
+            "against courseTO()\n", max_bearing_error_2km,
+            max_bearing_error_10km);
+    printf("geo: along and cross track error %.2f cm above 0.02 %% of the "
+            "distance of the fix to the start of the leg\n",
+            max_track_error < 0 ? 0 : max_track_error);
+    printf("geo: old distance+courseTO %llu %s, geo %llu %s per fix, "
+            "%.1f times faster\n",
+            (unsigned long long)(old_cycles / TEST_LEGS), HOST_CYCLES_UNIT,
+            (unsigned long long)(fix_cycles / TEST_LEGS), HOST_CYCLES_UNIT,
+            fix_cycles > 0 ? (double)old_cycles / fix_cycles : 0.0);
+    printf("geo: geo_leg_initialize %llu %s per leg\n",
+            (unsigned long long)(leg_cycles / TEST_LEGS), HOST_CYCLES_UNIT);
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
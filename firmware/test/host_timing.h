@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/** host_timing
+
+  @Company
+    Schindelar
+
+  @File Name
+    host_timing.h
+
+  @Summary
+    Cycle counter of the host for the benchmarks of the host tests. On x86
+    it is the time stamp counter, on all other hosts the nanoseconds of the
+    monotonic clock. The host has an FPU and a divider, so the numbers only
+    compare the old and the new code with each other and are no cycles of
+    the Cortex-M0+
+ */
+/* ************************************************************************** */
+
+#ifndef _HOST_TIMING_H    /* Guard against multiple inclusion */
+#define _HOST_TIMING_H
+
+#include <stdint.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//this function returns the cycle counter of the host
+static inline uint64_t host_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+#endif
+}
+
+//unit of host_cycles for the output
+#if defined(__x86_64__) || defined(__i386__)
+#define HOST_CYCLES_UNIT "tsc cycles"
+#else
+#define HOST_CYCLES_UNIT "ns"
+#endif
+
+#endif /* _HOST_TIMING_H */
+
+/* *****************************************************************************
+ End of File
+ */
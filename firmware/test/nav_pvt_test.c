@@ -0,0 +1,363 @@
+/* ************************************************************************** */
+/** nav_pvt_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    nav_pvt_test.c
+
+  @Summary
+    Host test of the gps receive path. gps.c is included with a stand in of
+    the SERCOM3 plib, so the bytes run through the same receive callback,
+    line pool and gps_update as on the target. Built with GPS_PROTOCOL_UBX
+    it checks the decoding of NAV-PVT into gps_fix_t, the validity of its
+    time, the Fletcher checksum and the resynchronisation after foreign
+    frames and broken lengths. Built with both protocols it replays the
+    bytes of one fix and measures the bytes and the host cycles per fix
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "gps.c"
+#include "host_timing.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of fixes of the replay
+#define TEST_REPLAY_FIXES 100000
+
+//receive buffer and callback which gps.c gives to the plib
+static uint8_t* test_read_buffer = NULL;
+static SERCOM_USART_CALLBACK test_read_callback = NULL;
+
+//one stream of bytes for one fix
+static uint8_t test_stream[256];
+static uint16_t test_stream_length = 0;
+
+//amount of calls of systime_set_utc
+static uint32_t test_utc_count = 0;
+
+static int test_errors = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Stand in of the plib and the system time                          */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+USART_ERROR SERCOM3_USART_ErrorGet(void) {
+    return USART_ERROR_NONE;
+}
+
+bool SERCOM3_USART_Read(void* buffer, const size_t size) {
+    (void)size;
+    test_read_buffer = buffer;
+    return true;
+}
+
+bool SERCOM3_USART_ReadAbort(void) {
+    return true;
+}
+
+void SERCOM3_USART_ReadCallbackRegister(SERCOM_USART_CALLBACK callback,
+        uintptr_t context) {
+    (void)context;
+    test_read_callback = callback;
+}
+
+bool SERCOM3_USART_SerialSetup(USART_SERIAL_SETUP* setup,
+        uint32_t clkFrequency) {
+    (void)setup;
+    (void)clkFrequency;
+    return true;
+}
+
+bool SERCOM3_USART_TransmitComplete(void) {
+    return true;
+}
+
+bool SERCOM3_USART_Write(void* buffer, const size_t size) {
+    (void)buffer;
+    (void)size;
+    return true;
+}
+
+bool SERCOM3_USART_WriteIsBusy(void) {
+    return false;
+}
+
+uint32_t systime_get_ms(void) {
+    return 1000;
+}
+
+uint32_t systime_get_us(void) {
+    return 1000000;
+}
+
+void systime_set_utc(uint32_t utc_ms, uint32_t receive_us) {
+    (void)utc_ms;
+    (void)receive_us;
+    test_utc_count++;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function gives the bytes to the receive callback like the interrupt
+static void test_receive(const uint8_t* data, uint16_t length) {
+    for(uint16_t i = 0; i < length; i++) {
+        *test_read_buffer = data[i];
+        test_read_callback(0);
+    }
+}
+
+//this function counts a failed check
+static void test_check(bool condition, const char* text) {
+    if(!condition) {
+        printf("FAIL %s\n", text);
+        test_errors++;
+    }
+}
+
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+//this function writes a little endian number into the payload
+static void test_write_u32(uint8_t* data, uint32_t value) {
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+//this function builds an ubx frame with the sync characters and the
+//checksum and returns its length
+static uint16_t test_build_ubx(uint8_t message_class, uint8_t message_id,
+        const uint8_t* payload, uint16_t length, uint8_t* frame) {
+    uint8_t checksum_a = 0;
+    uint8_t checksum_b = 0;
+
+    frame[0] = 0xB5;
+    frame[1] = 0x62;
+    frame[2] = message_class;
+    frame[3] = message_id;
+    frame[4] = (uint8_t)length;
+    frame[5] = (uint8_t)(length >> 8);
+    memcpy(&frame[6], payload, length);
+    for(uint16_t i = 2; i < length + 6U; i++) {
+        checksum_a += frame[i];
+        checksum_b += checksum_a;
+    }
+    frame[length + 6U] = checksum_a;
+    frame[length + 7U] = checksum_b;
+    return length + 8U;
+}
+
+//this function builds the payload of a NAV-PVT frame, the values are the
+//position of the comment in nmea.h
+static void test_build_nav_pvt(uint8_t* payload, uint8_t fix_type,
+        uint8_t valid) {
+    memset(payload, 0, GPS_UBX_NAV_PVT_LENGTH);
+    payload[4] = (uint8_t)2023;     //year
+    payload[5] = (uint8_t)(2023 >> 8);
+    payload[6] = 6;                 //month
+    payload[7] = 17;                //day
+    payload[8] = 10;                //hour
+    payload[9] = 8;                 //minute
+    payload[10] = 55;               //second
+    payload[11] = valid;            //validDate, validTime, fullyResolved
+    test_write_u32(&payload[16], (uint32_t)-250000000L);   //nanoseconds
+    payload[20] = fix_type;
+    payload[21] = 0x03;             //gnssFixOK and diffSoln
+    payload[23] = 12;               //satellites
+    test_write_u32(&payload[24], 162904615);               //longitude
+    test_write_u32(&payload[28], 480739670);               //latitude
+    test_write_u32(&payload[32], 301900);                  //ellipsoid height
+    test_write_u32(&payload[36], 259800);                  //height above msl
+    test_write_u32(&payload[40], 1500);                    //hAcc
+    test_write_u32(&payload[44], 2500);                    //vAcc
+    test_write_u32(&payload[48], (uint32_t)-1234);         //velN
+    test_write_u32(&payload[52], 5678);                    //velE
+    test_write_u32(&payload[56], (uint32_t)-90);           //velD
+    test_write_u32(&payload[60], 5810);                    //gSpeed
+    test_write_u32(&payload[64], 7752000);                 //headMot
+    test_write_u32(&payload[68], 120);                     //sAcc
+    test_write_u32(&payload[72], 150000);                  //headAcc
+    payload[76] = 96;                                      //pDOP
+}
+
+//this function checks the decoding, the checksum and the resynchronisation
+static void test_nav_pvt(void) {
+    uint8_t payload[GPS_UBX_NAV_PVT_LENGTH];
+    uint8_t frame[GPS_UBX_NAV_PVT_LENGTH + 8];
+    uint32_t sequence = 0;
+
+    //a valid frame is published with all fields
+    test_build_nav_pvt(payload, 3, 0x07);
+    uint16_t length = test_build_ubx(0x01, 0x07, payload,
+            GPS_UBX_NAV_PVT_LENGTH, frame);
+    test_receive(frame, length);
+    gps_update();
+    const gps_fix_t* fix = gps_get_fix();
+    test_check(gps_has_new_fix(&sequence) && fix->sequence == 1,
+            "valid frame not published");
+    test_check(fix->latitude == 480739670 && fix->longitude == 162904615,
+            "position");
+    test_check(fix->altitude == 259800, "altitude above msl");
+    test_check(fix->time_ms == 36534750, "utc time with negative nanoseconds");
+    test_check(fix->date == 170623, "date");
+    test_check(fix->quality == 2 && fix->satellites == 12 && fix->hdop == 96,
+            "quality, satellites and dop");
+    test_check(fix->velocity_north == -1234 && fix->velocity_east == 5678
+            && fix->velocity_down == -90 && fix->ground_speed == 5810,
+            "velocity");
+    test_check(fix->course == 7752 && fix->course_accuracy == 150,
+            "course");
+    test_check(fix->horizontal_accuracy == 1500
+            && fix->vertical_accuracy == 2500 && fix->speed_accuracy == 120,
+            "accuracy");
+
+    test_check(test_utc_count == 1, "valid time not given to the clock");
+
+    //a fix with a time which is not valid or not fully resolved is
+    //published without moving the clock
+    test_build_nav_pvt(payload, 3, 0x03);
+    length = test_build_ubx(0x01, 0x07, payload, GPS_UBX_NAV_PVT_LENGTH, frame);
+    test_receive(frame, length);
+    test_build_nav_pvt(payload, 3, 0x05);
+    length = test_build_ubx(0x01, 0x07, payload, GPS_UBX_NAV_PVT_LENGTH, frame);
+    test_receive(frame, length);
+    gps_update();
+    test_check(gps_has_new_fix(&sequence) && fix->sequence == 3,
+            "fix without a valid time not published");
+    test_check(test_utc_count == 1,
+            "time without validTime given to the clock");
+
+    //a wrong checksum loses the frame
+    uint32_t lost = gps_get_lost_sentences();
+    frame[length - 1] ^= 0x55;
+    test_receive(frame, length);
+    gps_update();
+    test_check(!gps_has_new_fix(&sequence), "wrong checksum published");
+    test_check(gps_get_lost_sentences() == lost + 1, "wrong checksum not lost");
+
+    //a frame without a fix is not published
+    test_build_nav_pvt(payload, 1, 0x07);
+    length = test_build_ubx(0x01, 0x07, payload, GPS_UBX_NAV_PVT_LENGTH, frame);
+    test_receive(frame, length);
+    gps_update();
+    test_check(!gps_has_new_fix(&sequence), "dead reckoning fix published");
+
+    //a foreign frame with sync characters and '$' in its payload is read to
+    //its end and the next NAV-PVT is found again
+    uint8_t foreign_payload[16];
+    uint8_t foreign[24];
+    memset(foreign_payload, '$', sizeof(foreign_payload));
+    foreign_payload[3] = 0xB5;
+    foreign_payload[4] = 0x62;
+    uint32_t dropped = gps_get_dropped_bytes();
+    length = test_build_ubx(0x01, 0x35, foreign_payload,
+            sizeof(foreign_payload), foreign);
+    test_receive(foreign, length);
+    test_check(gps_get_dropped_bytes() == dropped + length,
+            "foreign frame not dropped");
+    test_build_nav_pvt(payload, 3, 0x07);
+    length = test_build_ubx(0x01, 0x07, payload, GPS_UBX_NAV_PVT_LENGTH, frame);
+    test_receive(frame, length);
+    gps_update();
+    test_check(gps_has_new_fix(&sequence) && fix->sequence == 4,
+            "no resynchronisation after a foreign frame");
+
+    //a broken header with a length above the limit is not read to its end,
+    //the next frame is found again directly behind it
+    uint8_t broken[6] = {0xB5, 0x62, 0x01, 0x07, 0xFF, 0xFF};
+    lost = gps_get_lost_sentences();
+    test_receive(broken, sizeof(broken));
+    test_receive(frame, length);
+    gps_update();
+    test_check(gps_has_new_fix(&sequence) && fix->sequence == 5,
+            "no resynchronisation after a too long frame");
+    test_check(gps_get_lost_sentences() == lost + 1,
+            "too long frame not lost");
+
+    //a sync character in the middle of a nmea sentence ends the sentence
+    lost = gps_get_lost_sentences();
+    test_receive((const uint8_t*)"$GPGSV,3,1,11,01", 16);
+    test_receive(frame, length);
+    gps_update();
+    test_check(gps_has_new_fix(&sequence) && fix->sequence == 6,
+            "frame after a broken sentence");
+    test_check(gps_get_lost_sentences() == lost + 1,
+            "broken sentence not lost");
+}
+#endif
+
+//this function builds the bytes of one fix of the protocol
+static void test_build_stream(void) {
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+    uint8_t payload[GPS_UBX_NAV_PVT_LENGTH];
+    test_build_nav_pvt(payload, 3, 0x07);
+    test_stream_length = test_build_ubx(0x01, 0x07, payload,
+            GPS_UBX_NAV_PVT_LENGTH, test_stream);
+#else
+    //the modul sends VTG before GGA for every fix
+    const char* lines =
+            "$GNVTG,77.52,T,,M,0.004,N,0.008,K,A*3D\r\n"
+            "$GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,"
+            "42.1,M,,*4C\r\n";
+    test_stream_length = (uint16_t)strlen(lines);
+    memcpy(test_stream, lines, test_stream_length);
+#endif
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    const char* name = GPS_PROTOCOL == GPS_PROTOCOL_UBX ? "nav-pvt" : "gga";
+    uint32_t sequence = 0;
+
+    gps_initialize();
+#if GPS_PROTOCOL == GPS_PROTOCOL_UBX
+    test_nav_pvt();
+#endif
+
+    //replay of the bytes of one fix through the interrupt and gps_update
+    test_build_stream();
+    gps_has_new_fix(&sequence);
+    uint32_t first = sequence;
+    uint64_t start = host_cycles();
+    for(uint32_t i = 0; i < TEST_REPLAY_FIXES; i++) {
+        test_receive(test_stream, test_stream_length);
+        gps_update();
+    }
+    uint64_t cycles = host_cycles() - start;
+    gps_has_new_fix(&sequence);
+    test_check(sequence - first == TEST_REPLAY_FIXES, "replay lost fixes");
+
+    printf("%s: %d errors\n", name, test_errors);
+    printf("%s: %u bytes and %llu %s per fix\n", name, test_stream_length,
+            (unsigned long long)(cycles / TEST_REPLAY_FIXES),
+            HOST_CYCLES_UNIT);
+    return test_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,202 @@
+/* ************************************************************************** */
+/** nmea_bench
+
+  @Company
+    Schindelar
+
+  @File Name
+    nmea_bench.c
+
+  @Summary
+    Host check and benchmark of the nmea tokenizer. Every GGA sentence of
+    the corpus is decoded with nmea_tokenize and nmea_parse_gga and compared
+    with the expected integers, then both the new decoder and the old sscanf
+    path of read_current_altitude and read_current_distance are timed per
+    sentence
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nmea.h"
+#include "host_timing.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of passes through the corpus for the timing
+#define BENCH_PASSES 20000
+
+//one sentence of the corpus without the checksum and its expected values
+typedef struct {
+    const char* body;       //sentence between the $ and the *
+    int32_t latitude;       //1e-7 degrees
+    int32_t longitude;      //1e-7 degrees
+    int32_t altitude;       //centimetres
+    uint32_t time_ms;
+    uint8_t satellites;
+    uint16_t hdop;
+} bench_sentence_t;
+
+static const bench_sentence_t bench_corpus[] = {
+    {"GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,259.8,M,42.1,M,,",
+        480739670, 162904615, 25980, 36535000, 12, 96},
+    {"GPGGA,235959.50,0000.00010,S,17959.99999,W,2,05,1.5,-12.34,M,0.0,M,,",
+        -17, -1799999998, -1234, 86399500, 5, 150},
+    {"GNGGA,000000.00,8959.99999,N,00000.00001,E,1,04,9.99,8848.86,M,,M,,",
+        899999998, 2, 884886, 0, 4, 999},
+    {"GNGGA,120000.25,3345.12345,S,15112.54321,E,1,09,0.7,45,M,-20.1,M,,",
+        -337520575, 1512090535, 4500, 43200250, 9, 70},
+};
+
+#define BENCH_CORPUS_SIZE (sizeof(bench_corpus) / sizeof(bench_corpus[0]))
+
+//complete sentences with the checksum
+static char bench_lines[BENCH_CORPUS_SIZE][100];
+
+//the result is written here, so the compiler can not remove the work
+static volatile int32_t bench_sink;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function builds the sentence with the $ and the *hh checksum
+static void bench_build_line(const char* body, char* line) {
+    uint8_t checksum = 0;
+
+    for(const char* c = body; *c != '\0'; c++) {
+        checksum ^= (uint8_t)*c;
+    }
+    sprintf(line, "$%s*%02X", body, checksum);
+}
+
+//the old conversion from degrees and minutes to degrees
+static double old_degree_minutes_to_degree(double tochange) {
+    int degrees = (int)tochange / 100;
+    double minutes = tochange - degrees * 100;
+    return minutes / 60 + degrees;
+}
+
+//the old path: read_current_altitude and read_current_distance both scanned
+//the sentence with sscanf for every fix
+static void old_decode(const char* line) {
+    char dummy_word1[100] = "";
+    char dummy_word2[5] = "";
+    char dummy_word3[5] = "";
+    double dummy_double1 = 0, dummy_double2 = 0, dummy_double3 = 0;
+    double dummy_double4 = 0;
+    int dummy_int1 = 0, dummy_int2 = 0;
+    double altitude = 0, latitude = 0, longitude = 0;
+
+    sscanf(line, "%s,%lf,%lf,%s,%lf,%s,%d,%d,%lf,%lf", dummy_word1,
+            &dummy_double1, &dummy_double2, dummy_word2, &dummy_double3,
+            dummy_word3, &dummy_int1, &dummy_int2, &dummy_double4, &altitude);
+    sscanf(line, "%s,%lf,%lf,%s,%lf,%s", dummy_word1, &dummy_double1,
+            &latitude, dummy_word2, &longitude, dummy_word3);
+    latitude = old_degree_minutes_to_degree(latitude);
+    longitude = old_degree_minutes_to_degree(longitude);
+    bench_sink = (int32_t)(altitude + latitude + longitude);
+}
+
+//the new path: one pass of the tokenizer and the integer decoder
+static bool new_decode(const char* line, nmea_gga_t* gga) {
+    nmea_sentence_t sentence;
+
+    return nmea_tokenize(line, &sentence) && nmea_parse_gga(&sentence, gga);
+}
+
+//this function checks the decoder against the expected values
+static int bench_check(void) {
+    int errors = 0;
+
+    for(size_t i = 0; i < BENCH_CORPUS_SIZE; i++) {
+        const bench_sentence_t* expected = &bench_corpus[i];
+        nmea_gga_t gga;
+
+        if(!new_decode(bench_lines[i], &gga)
+                || gga.latitude != expected->latitude
+                || gga.longitude != expected->longitude
+                || gga.altitude != expected->altitude
+                || gga.time_ms != expected->time_ms
+                || gga.satellites != expected->satellites
+                || gga.hdop != expected->hdop) {
+            printf("FAIL %s\n", bench_lines[i]);
+            errors++;
+        }
+    }
+
+    //a broken checksum and a number with too many digits are rejected
+    char line[100];
+    nmea_gga_t gga;
+    strcpy(line, bench_lines[0]);
+    line[strlen(line) - 1] ^= 1;
+    if(new_decode(line, &gga)) {
+        printf("FAIL wrong checksum accepted\n");
+        errors++;
+    }
+    bench_build_line("GNGGA,100855.00,4804.43802,N,01617.42769,E,1,12,0.96,"
+            "99999999999.9,M,42.1,M,,", line);
+    if(new_decode(line, &gga)) {
+        printf("FAIL altitude overflow accepted\n");
+        errors++;
+    }
+    return errors;
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    for(size_t i = 0; i < BENCH_CORPUS_SIZE; i++) {
+        bench_build_line(bench_corpus[i].body, bench_lines[i]);
+    }
+
+    int errors = bench_check();
+
+    uint64_t start = host_cycles();
+    for(int pass = 0; pass < BENCH_PASSES; pass++) {
+        for(size_t i = 0; i < BENCH_CORPUS_SIZE; i++) {
+            old_decode(bench_lines[i]);
+        }
+    }
+    uint64_t old_cycles = host_cycles() - start;
+
+    start = host_cycles();
+    for(int pass = 0; pass < BENCH_PASSES; pass++) {
+        for(size_t i = 0; i < BENCH_CORPUS_SIZE; i++) {
+            nmea_gga_t gga;
+            new_decode(bench_lines[i], &gga);
+            bench_sink = gga.altitude;
+        }
+    }
+    uint64_t new_cycles = host_cycles() - start;
+
+    uint64_t sentences = (uint64_t)BENCH_PASSES * BENCH_CORPUS_SIZE;
+    printf("nmea: %zu sentences checked, %d errors\n", BENCH_CORPUS_SIZE,
+            errors);
+    printf("nmea: old sscanf path %llu %s per sentence\n",
+            (unsigned long long)(old_cycles / sentences), HOST_CYCLES_UNIT);
+    printf("nmea: tokenizer %llu %s per sentence\n",
+            (unsigned long long)(new_cycles / sentences), HOST_CYCLES_UNIT);
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
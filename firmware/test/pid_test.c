@@ -0,0 +1,250 @@
+/* ************************************************************************** */
+/** pid_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    pid_test.c
+
+  @Summary
+    Host check of the integer PID controller. A random error sequence is
+    checked against the same controller in double, the derivative with
+    errors far apart against the limit of the change, the output against
+    its limits with the stopped integral and the integral against its limit
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "pid.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of random samples against the double controller
+#define TEST_SAMPLES 100000
+
+//allowed difference to the double controller in output units, the integer
+//controller rounds the derivative, the integral and the output
+#define TEST_LIMIT 2
+
+//state of the random generator, the samples are the same in every run
+static uint32_t test_random_state = 0x2545F491UL;
+
+static int test_errors = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns a random number from 0 to range - 1
+static uint32_t test_random(uint32_t range) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return test_random_state % range;
+}
+
+//this function checks one output of the controller
+static void test_output(const char* name, int32_t output, int32_t expected) {
+    if(output != expected) {
+        printf("FAIL %s: output %ld instead of %ld\n", name, (long)output,
+                (long)expected);
+        test_errors++;
+    }
+}
+
+//this function runs random errors and sample times through the controller.
+//Every output is checked against the controller in double from the state
+//before the sample, the integral has to grow with the error only while the
+//output is inside the limits and it has to stay inside its limit. The
+//function returns the largest difference of the output
+static int32_t test_random_sequence(void) {
+    const pid_parameter_t parameter = {
+        .kp = 384, .ki = 64, .kd = 32, .integral_limit = 200,
+        .output_min = -500, .output_max = 500
+    };
+    const double limit_ms = parameter.integral_limit * 1000.0;
+    pid_state_t state;
+    int32_t error = 0;
+    int32_t max_difference = 0;
+    int limited = 0;
+
+    pid_reset(&state);
+    for(int i = 0; i < TEST_SAMPLES; i++) {
+        //a slow random walk of the error in cm with samples of 20 to 220 ms
+        error += (int32_t)test_random(201) - 100;
+        if(error > 5000 || error < -5000) {
+            error /= 2;
+        }
+        uint32_t delta_ms = 20 + test_random(201);
+
+        double derivative = 0;
+        if(state.started) {
+            derivative = (error - (double)state.last_error) * 1000.0
+                    / delta_ms;
+        }
+        double integral = state.integral;
+        double output = (parameter.kp * (double)error
+                + parameter.ki * integral / 1000.0
+                + parameter.kd * derivative) / PID_GAIN_ONE;
+        if(output > parameter.output_max) {
+            output = parameter.output_max;
+        } else if(output < parameter.output_min) {
+            output = parameter.output_min;
+        }
+
+        int32_t result = pid_update(&parameter, &state, error, delta_ms);
+        int32_t difference = abs(result - (int32_t)floor(output));
+        if(difference > max_difference) {
+            max_difference = difference;
+        }
+
+        //the integral only grows while the output is inside the limits, an
+        //output just at a limit may have been inside or cut
+        double grown = fmin(fmax(integral + (double)error * delta_ms,
+                -limit_ms), limit_ms);
+        bool at_limit = result == parameter.output_min
+                || result == parameter.output_max;
+        if(at_limit) {
+            limited++;
+            if(state.integral == grown) {
+                integral = grown;
+            }
+        } else {
+            integral = grown;
+        }
+        if(state.integral != integral) {
+            printf("FAIL integral %ld instead of %.0f\n",
+                    (long)state.integral, integral);
+            test_errors++;
+        }
+    }
+
+    //the sequence has to reach the limits of the output
+    if(limited == 0) {
+        printf("FAIL the random sequence never limits the output\n");
+        test_errors++;
+    }
+    return max_difference;
+}
+
+//this function checks the derivative with errors whose difference does not
+//fit into 32 bits, the change is limited to PID_CHANGE_LIMIT with the sign
+//of the real change
+static void test_change_overflow(void) {
+    const pid_parameter_t parameter = {
+        .kp = 0, .ki = 0, .kd = PID_GAIN_ONE, .integral_limit = 0,
+        .output_min = INT32_MIN, .output_max = INT32_MAX
+    };
+    pid_state_t state;
+
+    pid_reset(&state);
+    test_output("first sample", pid_update(&parameter, &state,
+            INT32_MIN + 1, 1000), 0);
+    test_output("change up", pid_update(&parameter, &state, INT32_MAX,
+            1000), PID_CHANGE_LIMIT);
+    test_output("change down", pid_update(&parameter, &state,
+            INT32_MIN + 1, 1000), -PID_CHANGE_LIMIT);
+
+    //the limited change in 1 ms is the largest derivative
+    test_output("change in 1 ms", pid_update(&parameter, &state,
+            INT32_MAX, 1), PID_CHANGE_LIMIT * 1000);
+
+    //a sample without time has no derivative
+    test_output("no time", pid_update(&parameter, &state, 0, 0), 0);
+
+    //after the reset the first sample has no derivative again
+    pid_reset(&state);
+    test_output("after reset", pid_update(&parameter, &state, INT32_MAX,
+            1000), 0);
+}
+
+//this function checks the limits of the output, the integral stops while
+//the output is limited and grows again when it is inside
+static void test_saturation(void) {
+    const pid_parameter_t parameter = {
+        .kp = PID_GAIN_ONE, .ki = PID_GAIN_ONE, .kd = 0,
+        .integral_limit = 100, .output_min = -400, .output_max = 400
+    };
+    pid_state_t state;
+
+    //the largest error with the largest gain does not overflow the output
+    pid_reset(&state);
+    test_output("max error", pid_update(&parameter, &state, INT32_MAX,
+            UINT32_MAX), 400);
+    test_output("min error", pid_update(&parameter, &state, INT32_MIN,
+            UINT32_MAX), -400);
+    if(state.integral != 0) {
+        printf("FAIL integral %ld grows at the limit of the output\n",
+                (long)state.integral);
+        test_errors++;
+    }
+
+    //an error of 100 for 1 s is inside the limits, the integral is then
+    //100 error seconds and adds 100 to the next output
+    test_output("inside", pid_update(&parameter, &state, 100, 1000), 100);
+    test_output("integral", pid_update(&parameter, &state, 100, 1000), 200);
+
+    //the integral stops at its limit of 100 error seconds
+    test_output("integral limit", pid_update(&parameter, &state, 0, 1000),
+            100);
+    if(state.integral != 100 * 1000) {
+        printf("FAIL integral %ld above the limit\n", (long)state.integral);
+        test_errors++;
+    }
+
+    //the integral of the largest limit with the largest ki fits into the
+    //32 bits of the DIVAS
+    const pid_parameter_t large = {
+        .kp = 0, .ki = INT32_MAX / 1000 - 1, .kd = 0,
+        .integral_limit = INT32_MAX / 1000 - 1, .output_min = INT32_MIN,
+        .output_max = INT32_MAX
+    };
+    pid_reset(&state);
+    for(int i = 0; i < 4; i++) {
+        pid_update(&large, &state, INT32_MAX, UINT32_MAX);
+    }
+    int64_t expected = ((int64_t)large.ki * large.integral_limit)
+            >> PID_GAIN_SHIFT;
+    test_output("large integral", pid_update(&large, &state, 0, 0),
+            (int32_t)(expected > INT32_MAX ? INT32_MAX : expected));
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    int32_t max_difference = test_random_sequence();
+    if(max_difference > TEST_LIMIT) {
+        printf("FAIL output %ld away from the double controller\n",
+                (long)max_difference);
+        test_errors++;
+    }
+    test_change_overflow();
+    test_saturation();
+
+    printf("pid: %d samples, %ld away from the double controller, "
+            "%d errors\n", TEST_SAMPLES, (long)max_difference, test_errors);
+    return test_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,256 @@
+/* ************************************************************************** */
+/** predictor_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    predictor_test.c
+
+  @Summary
+    Host check of the alpha beta predictor. A simulated 5 Hz fix stream of
+    a flight at 5 m/s with noise is corrected into the filter and predicted
+    at the 50 Hz ticks of the control loop, the system time wraps during the
+    flight. The velocity has to converge and the prediction has to follow
+    the true position. The restart after a gap, the limit of the prediction
+    and the weighting of a fix with its HDOP are checked too
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "predictor.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//time between two fixes and two ticks in microseconds
+#define TEST_FIX_US 200000UL
+#define TEST_TICK_US 20000UL
+
+//true velocity of the flight in centimetres per second, 5 m/s
+#define TEST_VELOCITY_NORTH 300
+#define TEST_VELOCITY_EAST 400
+
+//standard deviation of the noise of the fixes in centimetres
+#define TEST_NOISE_CM 5.0
+
+//the filter has to converge in this time, the error is measured after it
+#define TEST_SETTLE_US 10000000UL
+#define TEST_FLIGHT_US 70000000UL
+
+//limits of the converged filter
+#define TEST_VELOCITY_LIMIT 5       //cm/s of the mean on every axis
+#define TEST_RMS_LIMIT 8.0          //cm at the ticks
+
+//the system time starts shortly before the wrap of the 32 bits
+#define TEST_START_US 0xFFF00000UL
+
+//state of the random generator, the noise is the same in every run
+static uint32_t test_random_state = 0x6C078965UL;
+
+static int test_errors = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns a random number between 0 and 1, without 0
+static double test_random(void) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return (test_random_state + 1.0) / 4294967297.0;
+}
+
+//this function returns a normal distributed noise in centimetres
+static double test_noise(void) {
+    return TEST_NOISE_CM * sqrt(-2.0 * log(test_random()))
+            * cos(2.0 * M_PI * test_random());
+}
+
+//this function checks one position or velocity of the filter
+static void test_value(const char* name, int32_t value, int32_t expected) {
+    if(value != expected) {
+        printf("FAIL %s: %ld instead of %ld\n", name, (long)value,
+                (long)expected);
+        test_errors++;
+    }
+}
+
+//this function flies the simulated stream and returns the RMS error of the
+//prediction at the ticks and the mean velocity after the filter settled,
+//the filter is left at the end of the flight
+static double test_flight(predictor_t* predictor, double* velocity,
+        uint32_t* end_us) {
+    double sum = 0;
+    uint32_t ticks = 0;
+
+    velocity[PREDICTOR_NORTH] = 0;
+    velocity[PREDICTOR_EAST] = 0;
+    *end_us = TEST_START_US;
+
+    predictor_reset(predictor);
+    for(uint32_t t = 0; t <= TEST_FLIGHT_US; t += TEST_TICK_US) {
+        uint32_t now_us = TEST_START_US + t;
+        double north = TEST_VELOCITY_NORTH * (t / 1e6);
+        double east = TEST_VELOCITY_EAST * (t / 1e6);
+
+        if(t % TEST_FIX_US == 0) {
+            int32_t fix[PREDICTOR_AXES] = {
+                (int32_t)lround(north + test_noise()),
+                (int32_t)lround(east + test_noise())
+            };
+            predictor_correct(predictor, fix, 100, now_us);
+        }
+
+        int32_t position[PREDICTOR_AXES];
+        if(!predictor_predict(predictor, now_us, position)) {
+            printf("FAIL no prediction after the first fix\n");
+            test_errors++;
+            break;
+        }
+        if(t >= TEST_SETTLE_US) {
+            sum += pow(position[PREDICTOR_NORTH] - north, 2)
+                    + pow(position[PREDICTOR_EAST] - east, 2);
+            velocity[PREDICTOR_NORTH] += predictor->velocity[PREDICTOR_NORTH];
+            velocity[PREDICTOR_EAST] += predictor->velocity[PREDICTOR_EAST];
+            ticks++;
+        }
+        *end_us = now_us;
+    }
+    velocity[PREDICTOR_NORTH] /= ticks;
+    velocity[PREDICTOR_EAST] /= ticks;
+    return sqrt(sum / ticks);
+}
+
+//this function checks the restart after a gap of more than 2 s and the
+//limit of the prediction during the gap
+static void test_gap(predictor_t* predictor, uint32_t last_us) {
+    int32_t limited[PREDICTOR_AXES], later[PREDICTOR_AXES];
+
+    //the prediction stops at the longest gap
+    predictor_predict(predictor, last_us + PREDICTOR_MAX_GAP_US, limited);
+    predictor_predict(predictor, last_us + 2 * PREDICTOR_MAX_GAP_US, later);
+    test_value("prediction after the gap north", later[PREDICTOR_NORTH],
+            limited[PREDICTOR_NORTH]);
+    test_value("prediction after the gap east", later[PREDICTOR_EAST],
+            limited[PREDICTOR_EAST]);
+
+    //a fix just inside the gap corrects the filter, the velocity is kept
+    predictor_t kept = *predictor;
+    int32_t fix[PREDICTOR_AXES] = {limited[0], limited[1]};
+    predictor_correct(&kept, fix, 100, last_us + PREDICTOR_MAX_GAP_US);
+    if(kept.velocity[PREDICTOR_NORTH] == 0
+            || kept.velocity[PREDICTOR_EAST] == 0) {
+        printf("FAIL fix inside the gap restarts the filter\n");
+        test_errors++;
+    }
+
+    //a fix after the gap restarts the filter at rest at the fix
+    fix[PREDICTOR_NORTH] = 123456;
+    fix[PREDICTOR_EAST] = -654321;
+    predictor_correct(predictor, fix, 100,
+            last_us + PREDICTOR_MAX_GAP_US + TEST_FIX_US);
+    test_value("restart north", predictor->position[PREDICTOR_NORTH],
+            fix[PREDICTOR_NORTH]);
+    test_value("restart east", predictor->position[PREDICTOR_EAST],
+            fix[PREDICTOR_EAST]);
+    test_value("restart velocity north", predictor->velocity[PREDICTOR_NORTH],
+            0);
+    test_value("restart velocity east", predictor->velocity[PREDICTOR_EAST],
+            0);
+}
+
+//this function corrects a filter at rest at 0 with a fix 10 m to the north
+//after one fix time and returns the corrected position
+static int32_t test_hdop_step(uint16_t hdop) {
+    predictor_t predictor;
+    int32_t origin[PREDICTOR_AXES] = {0, 0};
+    int32_t fix[PREDICTOR_AXES] = {1000, 0};
+
+    predictor_reset(&predictor);
+    predictor_correct(&predictor, origin, 100, 0);
+    predictor_correct(&predictor, fix, hdop, TEST_FIX_US);
+    return predictor.position[PREDICTOR_NORTH];
+}
+
+//this function checks the weighting with the HDOP, alpha is 192/256 up to
+//a HDOP of 1.0, then falls with the HDOP and stops at 32/256
+static void test_hdop(void) {
+    test_value("HDOP 0.5", test_hdop_step(50), 1000 * 192 / 256);
+    test_value("HDOP 1.0", test_hdop_step(100), 1000 * 192 / 256);
+    test_value("HDOP 3.0", test_hdop_step(300), 1000 * 64 / 256);
+    test_value("HDOP 50.0", test_hdop_step(5000), 1000 * 32 / 256);
+
+    //a worse fix never corrects more than a better one
+    int32_t last = test_hdop_step(100);
+    for(uint16_t hdop = 101; hdop <= 1000; hdop++) {
+        int32_t step = test_hdop_step(hdop);
+        if(step > last) {
+            printf("FAIL HDOP %u corrects more than a better fix\n", hdop);
+            test_errors++;
+            break;
+        }
+        last = step;
+    }
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    predictor_t predictor;
+    int32_t position[PREDICTOR_AXES];
+
+    //there is no prediction before the first fix
+    predictor_reset(&predictor);
+    if(predictor_predict(&predictor, 0, position)) {
+        printf("FAIL prediction without a fix\n");
+        test_errors++;
+    }
+
+    uint32_t end_us;
+    double velocity[PREDICTOR_AXES];
+    double rms = test_flight(&predictor, velocity, &end_us);
+    if(fabs(velocity[PREDICTOR_NORTH] - TEST_VELOCITY_NORTH)
+            > TEST_VELOCITY_LIMIT
+            || fabs(velocity[PREDICTOR_EAST] - TEST_VELOCITY_EAST)
+            > TEST_VELOCITY_LIMIT) {
+        printf("FAIL velocity %.1f %.1f cm/s instead of %d %d cm/s\n",
+                velocity[PREDICTOR_NORTH], velocity[PREDICTOR_EAST],
+                TEST_VELOCITY_NORTH, TEST_VELOCITY_EAST);
+        test_errors++;
+    }
+    if(rms > TEST_RMS_LIMIT) {
+        printf("FAIL RMS error %.2f cm at the ticks\n", rms);
+        test_errors++;
+    }
+    test_gap(&predictor, end_us);
+    test_hdop();
+
+    printf("predictor: 5 Hz fixes with %.0f cm noise at 5 m/s, mean velocity "
+            "%.1f %.1f cm/s, %.2f cm RMS at 50 Hz, %d errors\n",
+            TEST_NOISE_CM, velocity[PREDICTOR_NORTH],
+            velocity[PREDICTOR_EAST], rms, test_errors);
+    return test_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
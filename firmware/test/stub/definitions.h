@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/** definitions
+
+  @Company
+    Schindelar
+
+  @File Name
+    definitions.h
+
+  @Summary
+    Host stand in for the Harmony definitions.h, it only declares the parts
+    of the SERCOM3 plib which gps.c uses. The functions are defined by the
+    test which includes gps.c
+ */
+/* ************************************************************************** */
+
+#ifndef _DEFINITIONS_H    /* Guard against multiple inclusion */
+#define _DEFINITIONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CPU_CLOCK_FREQUENCY 48000000UL
+
+//memory barrier of the Cortex-M0+, the host test runs in one thread
+#define __DMB() __sync_synchronize()
+
+typedef uint16_t USART_ERROR;
+#define USART_ERROR_NONE 0
+
+typedef enum {
+    USART_DATA_8_BIT = 3,
+} USART_DATA;
+
+typedef enum {
+    USART_PARITY_NONE = 2,
+} USART_PARITY;
+
+typedef enum {
+    USART_STOP_1_BIT = 0,
+} USART_STOP;
+
+typedef struct {
+    uint32_t baudRate;
+    USART_PARITY parity;
+    USART_DATA dataWidth;
+    USART_STOP stopBits;
+} USART_SERIAL_SETUP;
+
+typedef void (*SERCOM_USART_CALLBACK)(uintptr_t context);
+
+USART_ERROR SERCOM3_USART_ErrorGet(void);
+bool SERCOM3_USART_Read(void* buffer, const size_t size);
+bool SERCOM3_USART_ReadAbort(void);
+void SERCOM3_USART_ReadCallbackRegister(SERCOM_USART_CALLBACK callback,
+        uintptr_t context);
+bool SERCOM3_USART_SerialSetup(USART_SERIAL_SETUP* setup, uint32_t clkFrequency);
+bool SERCOM3_USART_TransmitComplete(void);
+bool SERCOM3_USART_Write(void* buffer, const size_t size);
+bool SERCOM3_USART_WriteIsBusy(void);
+
+#endif /* _DEFINITIONS_H */
+
+/* *****************************************************************************
+ End of File
+ */
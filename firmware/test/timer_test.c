@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/** timer_test
+
+  @Company
+    Schindelar
+
+  @File Name
+    timer_test.c
+
+  @Summary
+    Host check of the software timers across the wrap of the 32 bit
+    milliseconds after 49 days. The system time is a stand in which the test
+    moves on, the timers are polled with timer_update like in the main loop.
+    One shot and periodic timers, the skip of missed periods and the
+    callbacks next to timer_expired are checked
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "timer.h"
+#include "systime.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//the 32 bit milliseconds wrap at this time
+#define TEST_WRAP_MS (1ULL << 32)
+
+//system time of the stand in
+static uint64_t test_ms = 0;
+
+//calls of the callbacks
+static uint32_t test_callbacks = 0;
+
+static int test_errors = 0;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//stand in of the system time, the timers only use the 64 bit milliseconds
+uint64_t systime_get_ms64(void) {
+    return test_ms;
+}
+
+//callback of the timers
+static void test_callback(void) {
+    test_callbacks++;
+}
+
+//this function checks one value
+static void test_value(const char* name, uint64_t value, uint64_t expected) {
+    if(value != expected) {
+        printf("FAIL %s: %llu instead of %llu\n", name,
+                (unsigned long long)value, (unsigned long long)expected);
+        test_errors++;
+    }
+}
+
+//this function moves the system time on millisecond by millisecond and
+//polls the timers like the main loop, it returns the amount of
+//timer_expired which returned true on the way
+static uint32_t test_run(uint8_t timer, uint32_t ms) {
+    uint32_t expired = 0;
+
+    for(uint32_t i = 0; i < ms; i++) {
+        test_ms++;
+        timer_update();
+        if(timer_expired(timer)) {
+            expired++;
+        }
+    }
+    return expired;
+}
+
+//this function checks a one shot timer which runs out after the wrap
+static void test_one_shot(void) {
+    test_ms = TEST_WRAP_MS - 5;
+    test_callbacks = 0;
+    timer_start(TIMER_STATE, 10, false, test_callback);
+    test_value("remaining before the wrap", timer_remaining_ms(TIMER_STATE),
+            10);
+
+    test_value("expired before the deadline", test_run(TIMER_STATE, 9), 0);
+    test_value("remaining after the wrap", timer_remaining_ms(TIMER_STATE),
+            1);
+    test_value("running after the wrap", timer_is_running(TIMER_STATE), 1);
+
+    test_value("expired at the deadline", test_run(TIMER_STATE, 1), 1);
+    test_value("one shot callbacks", test_callbacks, 1);
+    test_value("running after the deadline", timer_is_running(TIMER_STATE),
+            0);
+    test_value("expired later", test_run(TIMER_STATE, 100), 0);
+    test_value("one shot callbacks later", test_callbacks, 1);
+}
+
+//this function checks a periodic timer across the wrap, the deadlines are
+//counted from the last one so the timer does not drift
+static void test_periodic(void) {
+    test_ms = TEST_WRAP_MS - 1000;
+    test_callbacks = 0;
+    timer_start(TIMER_OVERWEIGHT, 3, true, test_callback);
+
+    test_value("periodic expired", test_run(TIMER_OVERWEIGHT, 3000), 1000);
+    test_value("periodic callbacks", test_callbacks, 1000);
+    test_value("periodic remaining", timer_remaining_ms(TIMER_OVERWEIGHT),
+            3);
+
+    //a delay of the main loop skips the missed periods, the next deadline
+    //is one period after the late poll
+    test_ms += 23;
+    timer_update();
+    test_value("late callbacks", test_callbacks, 1001);
+    test_value("late expired", timer_expired(TIMER_OVERWEIGHT), 1);
+    test_value("late remaining", timer_remaining_ms(TIMER_OVERWEIGHT), 3);
+
+    timer_stop(TIMER_OVERWEIGHT);
+    test_value("stopped expired", test_run(TIMER_OVERWEIGHT, 10), 0);
+    test_value("stopped callbacks", test_callbacks, 1001);
+}
+
+//this function checks that timer_expired does not take the run out away
+//from timer_update, the callback is called although the caller polls the
+//timer first
+static void test_expired_callback(void) {
+    test_ms = TEST_WRAP_MS - 2;
+    test_callbacks = 0;
+    timer_start(TIMER_COMMAND_REFRESH, 4, false, test_callback);
+
+    test_ms += 4;
+    test_value("expired before the update",
+            timer_expired(TIMER_COMMAND_REFRESH), 0);
+    timer_update();
+    test_value("callback after expired", test_callbacks, 1);
+    test_value("expired after the update",
+            timer_expired(TIMER_COMMAND_REFRESH), 1);
+    test_value("expired once", timer_expired(TIMER_COMMAND_REFRESH), 0);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    test_one_shot();
+    test_periodic();
+    test_expired_callback();
+
+    printf("timer: one shot and periodic timers across the wrap of the 32 "
+            "bit ms, %d errors\n", test_errors);
+    return test_errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */
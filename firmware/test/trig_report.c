@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/** trig_report
+
+  @Company
+    Schindelar
+
+  @File Name
+    trig_report.c
+
+  @Summary
+    Host report of the accuracy and the speed of every CORDIC tier. The
+    error of sin and cos is the largest difference of the results to the
+    double sin and cos in degrees of the circle, the error of atan2 the
+    largest difference of the angle, both over 1e6 random angles and
+    vectors. The speed is measured on the host against sin, cos and atan2
+    of libm, the host has an FPU, so the cycles of the Cortex-M0+ in trig.h
+    can not be measured here
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "trig.h"
+#include "host_timing.h"
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Variables Area                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//amount of random angles and vectors
+#define REPORT_SAMPLES 1000000
+
+//degrees of one binary angle step
+#define REPORT_DEGREES_PER_ANGLE (360.0 / 4294967296.0)
+
+//the tiers with the error written in trig.h in degrees
+typedef struct {
+    const char* name;
+    uint8_t tier;
+    double limit;
+} report_tier_t;
+
+static const report_tier_t report_tiers[] = {
+    {"TRIG_TIER_1_0", TRIG_TIER_1_0, 0.90},
+    {"TRIG_TIER_0_1", TRIG_TIER_0_1, 0.056},
+    {"TRIG_TIER_0_01", TRIG_TIER_0_01, 0.0070},
+    {"TRIG_TIER_0_001", TRIG_TIER_0_001, 0.00044},
+};
+
+#define REPORT_TIERS (sizeof(report_tiers) / sizeof(report_tiers[0]))
+
+//random angles and vectors, the same in every run
+static uint32_t report_angles[REPORT_SAMPLES];
+static int32_t report_x[REPORT_SAMPLES];
+static int32_t report_y[REPORT_SAMPLES];
+
+//the results are written here, so the compiler can not remove the work
+static volatile int64_t report_sink;
+static volatile double report_double_sink;
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Local Functions                                                   */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+//this function returns a random number of 32 bits
+static uint32_t report_random(void) {
+    static uint32_t state = 0x2545F491UL;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//this function returns the difference of two angles in degrees between 0
+//and 180
+static double report_angle_error(double a, double b) {
+    return fabs(fmod(a - b + 540.0, 360.0) - 180.0);
+}
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Main Entry Point                                                  */
+/* ************************************************************************** */
+/* ************************************************************************** */
+
+int main(void) {
+    int errors = 0;
+
+    //the vectors are not longer than INT32_MAX / 2 like the sums of the
+    //callers
+    for(int i = 0; i < REPORT_SAMPLES; i++) {
+        report_angles[i] = report_random();
+        report_x[i] = (int32_t)report_random() / 2;
+        report_y[i] = (int32_t)report_random() / 2;
+    }
+
+    //the speed of libm for the comparison
+    uint64_t start = host_cycles();
+    for(int i = 0; i < REPORT_SAMPLES; i++) {
+        double angle = report_angles[i] * REPORT_DEGREES_PER_ANGLE
+                * M_PI / 180.0;
+        report_double_sink = sin(angle) + cos(angle);
+    }
+    uint64_t libm_sin_cos = (host_cycles() - start) / REPORT_SAMPLES;
+    start = host_cycles();
+    for(int i = 0; i < REPORT_SAMPLES; i++) {
+        report_double_sink = atan2(report_y[i], report_x[i]);
+    }
+    uint64_t libm_atan2 = (host_cycles() - start) / REPORT_SAMPLES;
+
+    printf("trig: speed in %s per call\n", HOST_CYCLES_UNIT);
+    printf("trig: tier             error sin/cos  error atan2    sin/cos  "
+            "atan2\n");
+    printf("trig: libm double      -              -              %7llu  "
+            "%5llu\n", (unsigned long long)libm_sin_cos,
+            (unsigned long long)libm_atan2);
+
+    for(size_t t = 0; t < REPORT_TIERS; t++) {
+        const report_tier_t* tier = &report_tiers[t];
+        double max_sin_cos = 0;
+        double max_atan2 = 0;
+
+        for(int i = 0; i < REPORT_SAMPLES; i++) {
+            int32_t sin_q30, cos_q30;
+            double angle = report_angles[i] * REPORT_DEGREES_PER_ANGLE;
+            double radians = angle * M_PI / 180.0;
+
+            //the error of the value is taken in degrees of the circle, for
+            //small errors this is the change of the angle
+            trig_sin_cos(report_angles[i], tier->tier, &sin_q30, &cos_q30);
+            double sin_error = fabs(sin_q30 / (double)TRIG_ONE - sin(radians));
+            double cos_error = fabs(cos_q30 / (double)TRIG_ONE - cos(radians));
+            double error = fmax(sin_error, cos_error) * 180.0 / M_PI;
+            if(error > max_sin_cos) {
+                max_sin_cos = error;
+            }
+
+            trig_angle_t result = trig_atan2(report_y[i], report_x[i],
+                    tier->tier);
+            error = report_angle_error(
+                    (double)result * REPORT_DEGREES_PER_ANGLE,
+                    atan2(report_y[i], report_x[i]) * 180.0 / M_PI);
+            if(error > max_atan2) {
+                max_atan2 = error;
+            }
+        }
+
+        start = host_cycles();
+        for(int i = 0; i < REPORT_SAMPLES; i++) {
+            int32_t sin_q30, cos_q30;
+            trig_sin_cos(report_angles[i], tier->tier, &sin_q30, &cos_q30);
+            report_sink = (int64_t)sin_q30 + cos_q30;
+        }
+        uint64_t sin_cos_cycles = (host_cycles() - start) / REPORT_SAMPLES;
+        start = host_cycles();
+        for(int i = 0; i < REPORT_SAMPLES; i++) {
+            report_sink = trig_atan2(report_y[i], report_x[i], tier->tier);
+        }
+        uint64_t atan2_cycles = (host_cycles() - start) / REPORT_SAMPLES;
+
+        printf("trig: %-16s %9.5f deg  %9.5f deg  %7llu  %5llu\n",
+                tier->name, max_sin_cos, max_atan2,
+                (unsigned long long)sin_cos_cycles,
+                (unsigned long long)atan2_cycles);
+
+        //the limits of trig.h are rounded to two digits
+        if(max_sin_cos > tier->limit * 1.05
+                || max_atan2 > tier->limit * 1.05) {
+            printf("FAIL %s above %.5f degrees\n", tier->name, tier->limit);
+            errors++;
+        }
+    }
+    return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* *****************************************************************************
+ End of File
+ */